@@ -1,10 +1,23 @@
 
+#ifdef INSTANCED
+struct VertexInput
+{
+    @builtin(vertex_index) vertex_index : u32,
+    @location(0) position : vec2<f32>,
+    @location(1) axis_x : vec2<f32>,
+    @location(2) axis_y : vec2<f32>,
+    @location(3) uv_start : vec2<f32>,
+    @location(4) uv_end : vec2<f32>,
+    @location(5) color : vec4<f32>
+};
+#else
 struct VertexInput
 {
     @location(0) position : vec2<f32>,
     @location(1) uv : vec2<f32>,
     @location(2) color : vec4<f32>
 };
+#endif
 
 struct VertexOutput
 {
@@ -31,9 +44,27 @@ var<uniform> per_frame_data : PerFrameData;
 fn vs_main(in : VertexInput) -> VertexOutput 
 {
     var out: VertexOutput;
+#ifdef INSTANCED
+    var corners = array<vec2<f32>, 6>(
+        vec2<f32>(0.0, 0.0),
+        vec2<f32>(0.0, 1.0),
+        vec2<f32>(1.0, 1.0),
+        vec2<f32>(1.0, 1.0),
+        vec2<f32>(1.0, 0.0),
+        vec2<f32>(0.0, 0.0)
+    );
+
+    let corner = corners[in.vertex_index];
+    let position = in.position + in.axis_x * corner.x + in.axis_y * corner.y;
+
+    out.uv = mix(in.uv_start, in.uv_end, corner);
+    out.color = in.color;
+    out.clip_position = per_frame_data.viewProj * vec4<f32>(position, 0.0, 1.0);
+#else
     out.uv = in.uv;
     out.color = in.color;
     out.clip_position = per_frame_data.viewProj * vec4<f32>(in.position, 0.0, 1.0);
+#endif
 
     return out;
 }
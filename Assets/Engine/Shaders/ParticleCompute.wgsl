@@ -0,0 +1,150 @@
+struct Particle
+{
+    position : vec2<f32>,
+    velocity : vec2<f32>,
+    acceleration : vec2<f32>,
+    drag : f32,
+    life_remaining : f32,
+    start_color : vec4<f32>,
+    final_color : vec4<f32>,
+    start_size : f32,
+    final_size : f32,
+    start_rotation : f32,
+    final_rotation : f32,
+    inv_life_span : f32,
+    frame : u32,
+    slot : u32,
+    padding : f32
+};
+
+struct SimulationData
+{
+    delta_time : f32,
+    num_emitted : u32,
+    capacity : u32,
+    src : u32
+};
+
+struct DrawArgs
+{
+    vertex_count : u32,
+    instance_count : u32,
+    first_vertex : u32,
+    first_instance : u32
+};
+
+struct Counters
+{
+    alive : array<atomic<u32>, 2>,
+    slots : array<atomic<u32>>
+};
+
+@group(0)
+@binding(0)
+var<uniform> simulation_data : SimulationData;
+
+@group(0)
+@binding(1)
+var<storage, read_write> src_particles : array<Particle>;
+
+@group(0)
+@binding(2)
+var<storage, read_write> dst_particles : array<Particle>;
+
+@group(0)
+@binding(3)
+var<storage, read> emitted_particles : array<Particle>;
+
+@group(0)
+@binding(4)
+var<storage, read_write> counters : Counters;
+
+@group(0)
+@binding(5)
+var<storage, read_write> draw_args : array<DrawArgs>;
+
+@group(0)
+@binding(6)
+var<storage, read_write> slot_offsets : array<u32>;
+
+@compute
+@workgroup_size(64)
+fn cs_emit(@builtin(global_invocation_id) id : vec3<u32>)
+{
+    if (id.x >= simulation_data.num_emitted)
+    {
+        return;
+    }
+
+    let index = atomicAdd(&counters.alive[simulation_data.src], 1u);
+    if (index < simulation_data.capacity)
+    {
+        src_particles[index] = emitted_particles[id.x];
+    }
+}
+
+@compute
+@workgroup_size(64)
+fn cs_simulate(@builtin(global_invocation_id) id : vec3<u32>)
+{
+    let num_alive = min(atomicLoad(&counters.alive[simulation_data.src]), simulation_data.capacity);
+    if (id.x >= num_alive)
+    {
+        return;
+    }
+
+    var particle = src_particles[id.x];
+    let delta_time = simulation_data.delta_time;
+
+    particle.life_remaining -= delta_time;
+    if (particle.life_remaining >= 0.0)
+    {
+        particle.velocity = (particle.velocity + particle.acceleration * delta_time) * particle.drag;
+        particle.position += particle.velocity * delta_time;
+
+        atomicAdd(&counters.slots[particle.slot], 1u);
+    }
+
+    src_particles[id.x] = particle;
+}
+
+@compute
+@workgroup_size(1)
+fn cs_finalize()
+{
+    var offset = 0u;
+    for (var slot = 0u; slot < arrayLength(&draw_args); slot++)
+    {
+        let count = atomicLoad(&counters.slots[slot]);
+
+        draw_args[slot].vertex_count = 6u;
+        draw_args[slot].instance_count = count;
+        draw_args[slot].first_vertex = 0u;
+        draw_args[slot].first_instance = 0u;
+
+        slot_offsets[slot] = offset;
+        offset += count;
+    }
+
+    atomicStore(&counters.alive[1u - simulation_data.src], offset);
+}
+
+@compute
+@workgroup_size(64)
+fn cs_compact(@builtin(global_invocation_id) id : vec3<u32>)
+{
+    let num_alive = min(atomicLoad(&counters.alive[simulation_data.src]), simulation_data.capacity);
+    if (id.x >= num_alive)
+    {
+        return;
+    }
+
+    let particle = src_particles[id.x];
+    if (particle.life_remaining < 0.0)
+    {
+        return;
+    }
+
+    let index = atomicSub(&counters.slots[particle.slot], 1u) - 1u;
+    dst_particles[slot_offsets[particle.slot] + index] = particle;
+}
\ No newline at end of file
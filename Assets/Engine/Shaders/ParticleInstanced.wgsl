@@ -0,0 +1,138 @@
+struct Particle
+{
+    position : vec2<f32>,
+    velocity : vec2<f32>,
+    acceleration : vec2<f32>,
+    drag : f32,
+    life_remaining : f32,
+    start_color : vec4<f32>,
+    final_color : vec4<f32>,
+    start_size : f32,
+    final_size : f32,
+    start_rotation : f32,
+    final_rotation : f32,
+    inv_life_span : f32,
+    frame : u32,
+    slot : u32,
+    padding : f32
+};
+
+struct Frame
+{
+    uv_rect : vec4<f32>,
+    slot : u32,
+    padding : vec3<u32>
+};
+
+struct VertexOutput
+{
+    @builtin(position) clip_position : vec4<f32>,
+    @location(0) uv : vec2<f32>,
+    @location(1) color : vec4<f32>
+};
+
+struct FragmentOutput
+{
+    @location(0) frag_color : vec4<f32>
+};
+
+struct PerFrameData
+{
+    viewProj : mat4x4<f32>,
+    root_transform : mat4x4<f32>
+};
+
+struct SlotData
+{
+    slot : u32,
+    padding : vec3<u32>
+};
+
+@group(0)
+@binding(0)
+var<uniform> per_frame_data : PerFrameData;
+
+@group(0)
+@binding(1)
+var<storage, read> particles : array<Particle>;
+
+@group(0)
+@binding(2)
+var<storage, read> frames : array<Frame>;
+
+@group(0)
+@binding(3)
+var<storage, read> slot_offsets : array<u32>;
+
+@group(1)
+@binding(0)
+var diffuse_sampler : sampler;
+
+@group(1)
+@binding(1)
+var diffuse_texture : texture_2d<f32>;
+
+@group(1)
+@binding(2)
+var<uniform> slot_data : SlotData;
+
+@vertex
+fn vs_main(@builtin(vertex_index) vertex_index : u32, @builtin(instance_index) instance_index : u32) -> VertexOutput 
+{
+    var out: VertexOutput;
+
+    let particle = particles[slot_offsets[slot_data.slot] + instance_index];
+    let frame = frames[particle.frame];
+
+    let life = particle.life_remaining * particle.inv_life_span;
+    let size = mix(particle.final_size, particle.start_size, life);
+    let rotation = mix(particle.final_rotation, particle.start_rotation, life);
+
+    var corners = array<vec2<f32>, 6>(
+        vec2<f32>(-0.5, -0.5),
+        vec2<f32>(-0.5, 0.5),
+        vec2<f32>(0.5, 0.5),
+        vec2<f32>(0.5, 0.5),
+        vec2<f32>(0.5, -0.5),
+        vec2<f32>(-0.5, -0.5)
+    );
+
+    let corner = corners[vertex_index];
+    let c = cos(rotation);
+    let s = sin(rotation);
+    let local = particle.position + vec2<f32>(c * corner.x - s * corner.y, s * corner.x + c * corner.y) * size;
+    let world = per_frame_data.root_transform * vec4<f32>(local, 0.0, 1.0);
+
+    let uv_min = frame.uv_rect.xy;
+    let uv_max = frame.uv_rect.zw;
+
+    out.uv = vec2<f32>(
+        select(uv_max.x, uv_min.x, corner.x < 0.0),
+        select(uv_min.y, uv_max.y, corner.y < 0.0)
+    );
+
+    out.color = mix(particle.final_color, particle.start_color, life);
+    out.clip_position = per_frame_data.viewProj * world;
+
+    return out;
+}
+
+@fragment
+fn fs_textured(in: VertexOutput) -> FragmentOutput {
+    var c = textureSample(diffuse_texture, diffuse_sampler, in.uv);
+    var r = c.rgb * (1.0 - in.color.a) + in.color.rgb * in.color.a;
+    var color = vec4<f32>(r.r, r.g, r.b, c.a);
+
+    var out: FragmentOutput;    
+    out.frag_color = color;
+
+    return out;
+}
+
+@fragment
+fn fs_colored(in: VertexOutput) -> FragmentOutput {
+    var out: FragmentOutput;    
+    out.frag_color = in.color;
+
+    return out;
+}
\ No newline at end of file
@@ -1,16 +1,32 @@
 
+#ifdef INSTANCED
+struct VertexInput
+{
+    @builtin(vertex_index) vertex_index : u32,
+    @location(0) position : vec2<f32>,
+    @location(1) axis_x : vec2<f32>,
+    @location(2) axis_y : vec2<f32>,
+    @location(3) uv_start : vec2<f32>,
+    @location(4) uv_end : vec2<f32>,
+    @location(5) color : vec4<f32>
+};
+#else
 struct VertexInput
 {
     @location(0) position : vec2<f32>,
     @location(1) uv : vec2<f32>,
     @location(2) color : vec4<f32>
 };
+#endif
 
 struct VertexOutput
 {
     @builtin(position) clip_position : vec4<f32>,
     @location(0) uv : vec2<f32>,
-    @location(1) color : vec4<f32>
+    @location(1) color : vec4<f32>,
+#ifdef TEXTURE_ARRAY
+    @location(2) @interpolate(flat) slot : u32
+#endif
 };
 
 struct FragmentOutput
@@ -31,24 +47,102 @@ var<uniform> per_frame_data : PerFrameData;
 @binding(0)
 var diffuse_sampler : sampler;
 
+#ifdef TEXTURE_ARRAY
+@group(1)
+@binding(1)
+var diffuse_texture0 : texture_2d<f32>;
+
+@group(1)
+@binding(2)
+var diffuse_texture1 : texture_2d<f32>;
+
+@group(1)
+@binding(3)
+var diffuse_texture2 : texture_2d<f32>;
+
+@group(1)
+@binding(4)
+var diffuse_texture3 : texture_2d<f32>;
+
+@group(1)
+@binding(5)
+var diffuse_texture4 : texture_2d<f32>;
+
+@group(1)
+@binding(6)
+var diffuse_texture5 : texture_2d<f32>;
+
+@group(1)
+@binding(7)
+var diffuse_texture6 : texture_2d<f32>;
+
+@group(1)
+@binding(8)
+var diffuse_texture7 : texture_2d<f32>;
+#else
 @group(1)
 @binding(1)
 var diffuse_texture : texture_2d<f32>;
+#endif
 
 @vertex
+#ifdef TEXTURE_ARRAY
+fn vs_main(in : VertexInput, @location(7) slot : u32) -> VertexOutput 
+#else
 fn vs_main(in : VertexInput) -> VertexOutput 
+#endif
 {
     var out: VertexOutput;
+#ifdef INSTANCED
+    var corners = array<vec2<f32>, 6>(
+        vec2<f32>(0.0, 0.0),
+        vec2<f32>(0.0, 1.0),
+        vec2<f32>(1.0, 1.0),
+        vec2<f32>(1.0, 1.0),
+        vec2<f32>(1.0, 0.0),
+        vec2<f32>(0.0, 0.0)
+    );
+
+    let corner = corners[in.vertex_index];
+    let position = in.position + in.axis_x * corner.x + in.axis_y * corner.y;
+
+    out.uv = mix(in.uv_start, in.uv_end, corner);
+    out.color = in.color;
+    out.clip_position = per_frame_data.viewProj * vec4<f32>(position, 0.0, 1.0);
+#else
     out.uv = in.uv;
     out.color = in.color;
     out.clip_position = per_frame_data.viewProj * vec4<f32>(in.position, 0.0, 1.0);
+#endif
+
+#ifdef TEXTURE_ARRAY
+    out.slot = slot;
+#endif
 
     return out;
 }
 
 @fragment
 fn fs_main(in: VertexOutput) -> FragmentOutput {
+#ifdef TEXTURE_ARRAY
+    let dx = dpdx(in.uv);
+    let dy = dpdy(in.uv);
+
+    var c : vec4<f32>;
+    switch (in.slot)
+    {
+        case 1u: { c = textureSampleGrad(diffuse_texture1, diffuse_sampler, in.uv, dx, dy); }
+        case 2u: { c = textureSampleGrad(diffuse_texture2, diffuse_sampler, in.uv, dx, dy); }
+        case 3u: { c = textureSampleGrad(diffuse_texture3, diffuse_sampler, in.uv, dx, dy); }
+        case 4u: { c = textureSampleGrad(diffuse_texture4, diffuse_sampler, in.uv, dx, dy); }
+        case 5u: { c = textureSampleGrad(diffuse_texture5, diffuse_sampler, in.uv, dx, dy); }
+        case 6u: { c = textureSampleGrad(diffuse_texture6, diffuse_sampler, in.uv, dx, dy); }
+        case 7u: { c = textureSampleGrad(diffuse_texture7, diffuse_sampler, in.uv, dx, dy); }
+        default: { c = textureSampleGrad(diffuse_texture0, diffuse_sampler, in.uv, dx, dy); }
+    }
+#else
     var c = textureSample(diffuse_texture, diffuse_sampler, in.uv);
+#endif
     var r = c.rgb * (1.0 - in.color.a) + in.color.rgb * in.color.a;
     var color = vec4<f32>(r.r, r.g, r.b, c.a);
 
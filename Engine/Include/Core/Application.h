@@ -10,6 +10,7 @@ using json = nlohmann::json;
 namespace Trinity
 {
     class Debugger;
+    class JobSystem;
     class Clock;
     class FileSystem;
     class Input;
@@ -68,6 +69,11 @@ namespace Trinity
             return mClock.get();
         }
 
+        JobSystem* getJobSystem() const
+        {
+            return mJobSystem.get();
+        }
+
         Window* getWindow() const
         {
             return mWindow.get();
@@ -120,6 +126,7 @@ namespace Trinity
         std::unique_ptr<Logger> mLogger{ nullptr };
         std::unique_ptr<Debugger> mDebugger{ nullptr };
         std::unique_ptr<Clock> mClock{ nullptr };
+        std::unique_ptr<JobSystem> mJobSystem{ nullptr };
         std::unique_ptr<Window> mWindow{ nullptr };
         std::unique_ptr<FileSystem> mFileSystem{ nullptr };
         std::unique_ptr<Input> mInput{ nullptr };
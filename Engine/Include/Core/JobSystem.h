@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Core/Singleton.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+
+namespace Trinity
+{
+	using Job = std::function<void()>;
+	using RangeJob = std::function<void(uint32_t, uint32_t)>;
+
+	struct JobTask
+	{
+		Job job;
+		std::atomic<uint32_t> numDependencies{ 1 };
+		std::atomic<bool> finished{ false };
+		std::mutex mutex;
+		std::vector<std::shared_ptr<JobTask>> continuations;
+	};
+
+	using JobHandle = std::shared_ptr<JobTask>;
+
+	class JobSystem : public Singleton<JobSystem>
+	{
+	public:
+
+		struct WorkerQueue
+		{
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+
+		JobSystem() = default;
+		virtual ~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator = (const JobSystem&) = delete;
+
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator = (JobSystem&&) = delete;
+
+		uint32_t getNumWorkers() const
+		{
+			return (uint32_t)mWorkers.size();
+		}
+
+		uint32_t getNumThreads() const
+		{
+			return (uint32_t)mWorkers.size() + 1;
+		}
+
+		static uint32_t getThreadIndex();
+
+		virtual bool create(uint32_t numWorkers);
+		virtual void destroy();
+
+		virtual JobHandle schedule(Job job);
+		virtual JobHandle schedule(Job job, const std::vector<JobHandle>& dependencies);
+		virtual void wait(const JobHandle& handle);
+		virtual void wait(const std::vector<JobHandle>& handles);
+
+		virtual void parallelFor(uint32_t count, uint32_t grainSize, const RangeJob& job);
+
+	protected:
+
+		virtual void execute(uint32_t threadIndex);
+		virtual void push(Job job);
+		virtual bool pop(Job& job);
+		virtual bool steal(Job& job);
+		virtual bool runJob();
+		virtual void finish(const JobHandle& handle);
+
+	protected:
+
+		std::vector<std::thread> mWorkers;
+		std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+		std::atomic<uint32_t> mNumQueued{ 0 };
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		bool mRunning{ false };
+	};
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -22,12 +24,36 @@ namespace Trinity
 	class IndexBuffer;
 	class RenderTarget;
 
+	enum class BatchVertexFormat
+	{
+		Standard,
+		Packed,
+		Instanced
+	};
+
+	enum class BatchTextureMode
+	{
+		Single,
+		Array
+	};
+
+	enum class BatchSortMode
+	{
+		None,
+		Texture
+	};
+
 	class BatchRenderer
 	{
 	public:
 
 		static constexpr uint32_t kCommonBindGroupIndex = 0;
 		static constexpr uint32_t kTextureBindGroupIndex = 1;
+		static constexpr uint32_t kNumFramesInFlight = 3;
+		static constexpr uint32_t kMaxQuadsPerDraw = 16384;
+		static constexpr uint32_t kMaxTextureSlots = 8;
+		static constexpr uint32_t kMaxTextureSets = 64;
+		static constexpr uint32_t kInvalidCustomDraw = 0xffffffff;
 
 		struct Vertex
 		{
@@ -36,6 +62,23 @@ namespace Trinity
 			glm::vec4 color{ 0.0f };
 		};
 
+		struct PackedVertex
+		{
+			glm::vec2 position{ 0.0f };
+			uint32_t uv{ 0 };
+			uint32_t color{ 0 };
+		};
+
+		struct QuadInstance
+		{
+			glm::vec2 position{ 0.0f };
+			uint32_t axisX{ 0 };
+			uint32_t axisY{ 0 };
+			uint32_t uvStart{ 0 };
+			uint32_t uvEnd{ 0 };
+			uint64_t color{ 0 };
+		};
+
 		struct PerFrameData
 		{
 			glm::mat4 viewProj;
@@ -43,9 +86,12 @@ namespace Trinity
 
 		struct DrawCommand
 		{
+			Texture* texture{ nullptr };
 			size_t textureId{ 0 };
-			uint32_t numIndices{ 0 };
-			uint32_t baseIndex{ 0 };
+			uint32_t numQuads{ 0 };
+			uint32_t baseVertex{ 0 };
+			uint32_t layer{ 0 };
+			uint32_t customDraw{ kInvalidCustomDraw };
 		};
 
 		struct RenderContext
@@ -56,25 +102,76 @@ namespace Trinity
 			RenderPipeline* coloredPipeline{ nullptr };
 			VertexLayout* vertexLayout{ nullptr };
 			VertexBuffer* vertexBuffer{ nullptr };
+			VertexLayout* slotLayout{ nullptr };
+			VertexBuffer* slotBuffer{ nullptr };
 			IndexBuffer* indexBuffer{ nullptr };
 			UniformBuffer* perFrameBuffer{ nullptr };
 			BindGroup* bindGroup{ nullptr };
 			BindGroupLayout* bindGroupLayout{ nullptr };
 		};
 
+		struct TextureSet
+		{
+			BindGroup* bindGroup{ nullptr };
+			std::vector<Texture*> textures;
+			uint64_t frameIndex{ 0 };
+		};
+
 		struct ImageContext
 		{
 			Sampler* sampler{ nullptr };
 			BindGroupLayout* bindGroupLayout{ nullptr };
 			std::unordered_map<size_t, BindGroup*> bindGroups;
+			std::unordered_map<size_t, TextureSet> textureSets;
+			std::vector<Texture*> setTextures;
 		};
 
 		struct StagingContext
 		{
 			uint32_t numVertices{ 0 };
-			uint32_t numIndices{ 0 };
 			std::vector<Vertex> vertices;
-			std::vector<uint32_t> indices;
+			std::vector<PackedVertex> packedVertices;
+			std::vector<QuadInstance> instances;
+			std::vector<uint32_t> slots;
+		};
+
+		struct ShardContext
+		{
+			uint32_t numVertices{ 0 };
+			uint32_t layer{ 0 };
+			Texture* currentTexture{ nullptr };
+			std::vector<Vertex> vertices;
+			std::vector<DrawCommand> commands;
+		};
+
+		struct RingContext
+		{
+			uint32_t capacity{ 0 };
+			uint32_t head{ 0 };
+			uint32_t used{ 0 };
+			uint64_t frameIndex{ 0 };
+			std::array<uint32_t, kNumFramesInFlight> frameSizes{};
+		};
+
+		struct SortContext
+		{
+			std::vector<uint64_t> keys;
+			std::vector<uint32_t> order;
+			std::vector<uint32_t> scratch;
+			std::vector<Vertex> vertices;
+			std::vector<DrawCommand> commands;
+			std::unordered_map<size_t, uint32_t> textureIndices;
+		};
+
+		struct Stats
+		{
+			uint64_t uploadedBytes{ 0 };
+			uint32_t numUploads{ 0 };
+			uint32_t numReallocations{ 0 };
+			uint32_t numDrawCalls{ 0 };
+			uint32_t numPipelineChanges{ 0 };
+			uint32_t numBindGroupChanges{ 0 };
+			uint32_t numTextureSetEvictions{ 0 };
 		};
 
 	public:
@@ -88,6 +185,36 @@ namespace Trinity
 		BatchRenderer(BatchRenderer&&) = default;
 		BatchRenderer& operator = (BatchRenderer&&) = default;
 
+		const Stats& getStats() const
+		{
+			return mStats;
+		}
+
+		BatchVertexFormat getVertexFormat() const
+		{
+			return mVertexFormat;
+		}
+
+		BatchTextureMode getTextureMode() const
+		{
+			return mTextureMode;
+		}
+
+		BatchSortMode getSortMode() const
+		{
+			return mSortMode;
+		}
+
+		uint32_t getLayer() const
+		{
+			return mLayer;
+		}
+
+		uint32_t getNumShards() const
+		{
+			return mNumShards;
+		}
+
 		virtual bool create(
 			RenderTarget& renderTarget, 
 			ResourceCache& cache, 
@@ -100,6 +227,13 @@ namespace Trinity
 		virtual void begin(const glm::mat4& viewProj);
 		virtual void end(const RenderPass& renderPass);
 		virtual void invalidateTexture(const Texture& texture);
+		virtual void resetStats();
+		virtual bool setVertexFormat(BatchVertexFormat vertexFormat);
+		virtual bool setTextureMode(BatchTextureMode textureMode);
+		virtual void setSortMode(BatchSortMode sortMode);
+		virtual void setLayer(uint32_t layer);
+		virtual void beginShards(uint32_t numShards);
+		virtual void setShardLayer(uint32_t shardIndex, uint32_t layer);
 
 		virtual bool drawRect(
 			const glm::vec2& position,
@@ -150,15 +284,46 @@ namespace Trinity
 			bool flipY = false
 		);
 
+		virtual bool drawShardQuad(uint32_t shardIndex, Texture* texture, const Vertex* vertices);
+		virtual void drawCustom(std::function<void(const RenderPass&, const glm::mat4&)> draw);
+
+		virtual Vertex* allocateQuads(Texture* texture, uint32_t numQuads);
+		virtual Vertex* allocateShardQuads(uint32_t shardIndex, Texture* texture, uint32_t numQuads);
+
+		static void buildTextureQuad(
+			Vertex* vertices,
+			const glm::vec2& invTextureSize,
+			const glm::vec2& srcPosition,
+			const glm::vec2& srcSize,
+			const glm::vec2& origin,
+			const glm::mat4& transform,
+			const glm::vec4& color,
+			bool flipX,
+			bool flipY
+		);
+
 	protected:
 
 		virtual void addVertices(const Vertex* vertices, uint32_t numVertices);
-		virtual void addIndices(const uint32_t* indices, uint32_t numIndices);
-		virtual bool addCommand(Texture* texture, uint32_t baseIndex, uint32_t numIndices);
+		virtual bool addCommand(Texture* texture, uint32_t baseVertex, uint32_t numQuads);
+		virtual bool mergeShards();
+		virtual void sortCommands();
+		virtual void resetFrame();
+		virtual void buildTextureSets();
+		virtual size_t closeTextureSet();
+		virtual BindGroup* getImageBindGroup(size_t textureId) const;
+		virtual void packVertices(uint32_t numVertices);
+		virtual void packInstances(uint32_t numVertices);
 
 		virtual bool createCommonBindGroup(uint32_t perFrameDataSize);
+		virtual bool createSampler();
 		virtual bool createImageBindGroup(const Texture& texture);
+		virtual BindGroup* createTextureSetBindGroup(const std::vector<Texture*>& textures);
+		virtual void evictTextureSets();
 		virtual bool createBufferData();
+		virtual bool growVertexBuffer(uint32_t numVertices);
+		virtual void advanceRing(RingContext& ring, uint64_t frameIndex);
+		virtual bool allocateRing(RingContext& ring, uint32_t count, uint32_t& offset);
 		virtual void setCustomBindGroups(const RenderPass& renderPass);
 		virtual void updatePerFrameBuffer(const glm::mat4& viewProj);
 
@@ -175,10 +340,21 @@ namespace Trinity
 		RenderContext mRenderContext;
 		ImageContext mImageContext;
 		StagingContext mStagingContext;
+		SortContext mSortContext;
+		std::vector<ShardContext> mShards;
+		uint32_t mNumShards{ 0 };
+		RingContext mVertexRing;
+		Stats mStats;
+		BatchVertexFormat mVertexFormat{ BatchVertexFormat::Standard };
+		BatchTextureMode mTextureMode{ BatchTextureMode::Single };
+		BatchSortMode mSortMode{ BatchSortMode::None };
+		uint32_t mLayer{ 0 };
 		ResourceCache* mResourceCache{ nullptr };
 		Texture* mCurrentTexture{ nullptr };
 		glm::vec2 mInvTextureSize{ 0.0f };
 		std::vector<DrawCommand> mCommands;
 		DrawCommand mColorCommand;
+		std::vector<std::function<void(const RenderPass&, const glm::mat4&)>> mCustomDraws;
+		glm::mat4 mViewProj{ 1.0f };
 	};
 }
\ No newline at end of file
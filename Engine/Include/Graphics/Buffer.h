@@ -31,7 +31,7 @@ namespace Trinity
 
         virtual std::type_index getType() const override;
 
-        void mapAsync(uint32_t offset, uint32_t size);
+        void mapAsync(uint32_t offset, uint32_t size, wgpu::MapMode mode = wgpu::MapMode::Write);
         void unmap();
 
         void write(uint32_t offset, uint32_t size, const void* data) const;
@@ -43,5 +43,6 @@ namespace Trinity
     protected:
 
         wgpu::Buffer mHandle{};
+        wgpu::MapMode mMapMode{ wgpu::MapMode::None };
     };
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Core/Resource.h"
+#include "Graphics/ComputePipeline.h"
+#include "Graphics/BindGroup.h"
+#include "Graphics/Buffer.h"
 #include <webgpu/webgpu_cpp.h>
 
 namespace Trinity
@@ -24,6 +27,11 @@ namespace Trinity
         virtual void end();
         virtual void submit();
 
+        virtual void dispatch(uint32_t workgroupCountX, uint32_t workgroupCountY = 1, uint32_t workgroupCountZ = 1) const;
+        virtual void setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup) const;
+        virtual void setPipeline(const ComputePipeline& pipeline) const;
+        virtual void copyBuffer(const Buffer& src, uint32_t srcOffset, const Buffer& dst, uint32_t dstOffset, uint32_t size) const;
+
 	protected:
 
 		wgpu::CommandEncoder mCommandEncoder{ nullptr };
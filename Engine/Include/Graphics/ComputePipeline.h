@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Core/Resource.h"
+#include "Graphics/Shader.h"
+#include "Graphics/BindGroupLayout.h"
+
+namespace Trinity
+{
+	static constexpr const char* kDefaultCSEntry = "cs_main";
+
+    struct ComputePipelineProperties
+    {
+        Shader* shader{ nullptr };
+        std::string csEntry{ kDefaultCSEntry };
+        std::vector<const BindGroupLayout*> bindGroupLayouts;
+    };
+
+    class ComputePipeline : public Resource
+    {
+	public:
+
+        ComputePipeline() = default;
+        ~ComputePipeline();
+
+        ComputePipeline(const ComputePipeline&) = delete;
+        ComputePipeline& operator = (const ComputePipeline&) = delete;
+
+        ComputePipeline(ComputePipeline&&) noexcept = default;
+        ComputePipeline& operator = (ComputePipeline&&) noexcept = default;
+
+        const wgpu::PipelineLayout& getLayout() const
+        {
+            return mLayout;
+        }
+
+        const wgpu::ComputePipeline& getHandle() const
+        {
+            return mHandle;
+        }
+
+		virtual bool create(const ComputePipelineProperties& computeProps);
+		virtual void destroy();
+
+		virtual std::type_index getType() const override;
+
+    private:
+
+        wgpu::PipelineLayout mLayout;
+        wgpu::ComputePipeline mHandle;
+    };
+}
\ No newline at end of file
@@ -49,12 +49,20 @@ namespace Trinity
             return mSwapChain;
         }
 
+        uint64_t getFrameIndex() const
+        {
+            return mFrameIndex;
+        }
+
         operator const wgpu::Device& () const
         {
             return mDevice;
         }
 
         virtual void create(const Window& window);
+        virtual void createHeadless(
+            wgpu::BackendType backendType = wgpu::BackendType::Undefined, 
+            bool forceFallbackAdapter = false);
         virtual void destroy();
 
         virtual bool setupSwapChain(
@@ -65,9 +73,11 @@ namespace Trinity
 
         virtual void setClearColor(const wgpu::Color& clearColor);
         virtual void present();
+        virtual void poll();
 
     protected:
 
+        virtual void requestAdapter(const WGPURequestAdapterOptions* options);
         virtual void setupDevice(wgpu::Device device);
         virtual void deviceLost(bool destroyed);
 
@@ -83,5 +93,6 @@ namespace Trinity
         wgpu::Device mDevice;
         wgpu::Queue mQueue;
         SwapChain mSwapChain;
+        uint64_t mFrameIndex{ 0 };
     };
 }
\ No newline at end of file
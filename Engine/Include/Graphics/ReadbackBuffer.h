@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Graphics/Buffer.h"
+
+namespace Trinity
+{
+	class ReadbackBuffer : public Buffer
+	{
+	public:
+
+		ReadbackBuffer() = default;
+		~ReadbackBuffer();
+
+		ReadbackBuffer(const ReadbackBuffer&) = delete;
+		ReadbackBuffer& operator = (const ReadbackBuffer&) = delete;
+
+		ReadbackBuffer(ReadbackBuffer&&) = default;
+		ReadbackBuffer& operator = (ReadbackBuffer&&) = default;
+
+		uint32_t getSize() const
+		{
+			return mSize;
+		}
+
+		virtual bool create(uint32_t size);
+		virtual void destroy();
+
+	protected:
+
+		uint32_t mSize{ 0 };
+	};
+}
\ No newline at end of file
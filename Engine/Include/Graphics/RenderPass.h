@@ -33,6 +33,8 @@ namespace Trinity
         virtual void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0,
             int32_t baseVertex = 0, uint32_t firstInstance = 0) const;
 
+        virtual void drawIndirect(const Buffer& indirectBuffer, uint64_t indirectOffset = 0) const;
+
         virtual void setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup) const;
         virtual void setPipeline(const RenderPipeline& pipeline) const;
         virtual void setVertexBuffer(uint32_t slot, const VertexBuffer& vertexBuffer) const;
@@ -22,7 +22,7 @@ namespace Trinity
 			return mSize;
 		}
 
-		virtual bool create(uint32_t size, const void* data = nullptr);
+		virtual bool create(uint32_t size, const void* data = nullptr, wgpu::BufferUsage usage = wgpu::BufferUsage::None);
 		virtual void destroy();
 
 	protected:
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Particle/ParticlePool.h"
+#include <memory>
+#include <vector>
+#include "glm/glm.hpp"
+
+namespace Trinity
+{
+	class RenderTarget;
+	class RenderPass;
+	class Shader;
+	class Sampler;
+	class Texture;
+	class ComputePipeline;
+	class RenderPipeline;
+	class UniformBuffer;
+	class StorageBuffer;
+	class ReadbackBuffer;
+	class BindGroup;
+	class BindGroupLayout;
+
+	class GpuParticlePool : public ParticlePool
+	{
+	public:
+
+		static constexpr const char* kComputeShader = "/Assets/Engine/Shaders/ParticleCompute.wgsl";
+		static constexpr const char* kRenderShader = "/Assets/Engine/Shaders/ParticleInstanced.wgsl";
+		static constexpr uint32_t kWorkgroupSize = 64;
+		static constexpr uint32_t kMaxFrames = 64;
+		static constexpr uint32_t kMaxSlots = kMaxFrames + 1;
+		static constexpr uint32_t kColoredSlot = 0;
+		static constexpr uint32_t kInvalidSlot = 0xffffffff;
+
+		struct GpuParticle
+		{
+			glm::vec2 position{ 0.0f };
+			glm::vec2 velocity{ 0.0f };
+			glm::vec2 acceleration{ 0.0f };
+			float drag{ 0.0f };
+			float lifeRemaining{ 0.0f };
+			glm::vec4 startColor{ 0.0f };
+			glm::vec4 finalColor{ 0.0f };
+			float startSize{ 0.0f };
+			float finalSize{ 0.0f };
+			float startRotation{ 0.0f };
+			float finalRotation{ 0.0f };
+			float invLifeSpan{ 0.0f };
+			uint32_t frame{ 0 };
+			uint32_t slot{ kColoredSlot };
+			float padding{ 0.0f };
+		};
+
+		struct GpuFrame
+		{
+			glm::vec4 uvRect{ 0.0f };
+			uint32_t slot{ kColoredSlot };
+			uint32_t padding[3]{};
+		};
+
+		struct DrawArgs
+		{
+			uint32_t vertexCount{ 6 };
+			uint32_t instanceCount{ 0 };
+			uint32_t firstVertex{ 0 };
+			uint32_t firstInstance{ 0 };
+		};
+
+		struct SimulationData
+		{
+			float deltaTime{ 0.0f };
+			uint32_t numEmitted{ 0 };
+			uint32_t capacity{ 0 };
+			uint32_t src{ 0 };
+		};
+
+		struct PerFrameData
+		{
+			glm::mat4 viewProj{ 1.0f };
+			glm::mat4 rootTransform{ 1.0f };
+		};
+
+		struct SlotData
+		{
+			uint32_t slot{ kColoredSlot };
+			uint32_t padding[3]{};
+		};
+
+		struct SlotContext
+		{
+			Texture* texture{ nullptr };
+			std::unique_ptr<UniformBuffer> slotBuffer{ nullptr };
+			std::unique_ptr<BindGroup> bindGroup{ nullptr };
+		};
+
+		struct ComputeContext
+		{
+			std::unique_ptr<Shader> shader{ nullptr };
+			std::unique_ptr<BindGroupLayout> bindGroupLayout{ nullptr };
+			std::unique_ptr<ComputePipeline> emitPipeline{ nullptr };
+			std::unique_ptr<ComputePipeline> simulatePipeline{ nullptr };
+			std::unique_ptr<ComputePipeline> finalizePipeline{ nullptr };
+			std::unique_ptr<ComputePipeline> compactPipeline{ nullptr };
+			std::unique_ptr<UniformBuffer> simulationBuffer{ nullptr };
+			std::unique_ptr<StorageBuffer> particleBuffers[2];
+			std::unique_ptr<StorageBuffer> emittedBuffer{ nullptr };
+			std::unique_ptr<StorageBuffer> counterBuffer{ nullptr };
+			std::unique_ptr<StorageBuffer> drawArgsBuffer{ nullptr };
+			std::unique_ptr<StorageBuffer> slotOffsetBuffer{ nullptr };
+			std::unique_ptr<ReadbackBuffer> readbackBuffer{ nullptr };
+			std::unique_ptr<BindGroup> bindGroups[2];
+		};
+
+		struct RenderContext
+		{
+			std::unique_ptr<Shader> shader{ nullptr };
+			std::unique_ptr<Sampler> sampler{ nullptr };
+			std::unique_ptr<BindGroupLayout> bindGroupLayout{ nullptr };
+			std::unique_ptr<BindGroupLayout> texturedLayout{ nullptr };
+			std::unique_ptr<BindGroupLayout> coloredLayout{ nullptr };
+			std::unique_ptr<RenderPipeline> texturedPipeline{ nullptr };
+			std::unique_ptr<RenderPipeline> coloredPipeline{ nullptr };
+			std::unique_ptr<UniformBuffer> perFrameBuffer{ nullptr };
+			std::unique_ptr<StorageBuffer> frameBuffer{ nullptr };
+			std::unique_ptr<BindGroup> bindGroups[2];
+		};
+
+		GpuParticlePool() = default;
+		virtual ~GpuParticlePool();
+
+		GpuParticlePool(const GpuParticlePool&) = delete;
+		GpuParticlePool& operator = (const GpuParticlePool&) = delete;
+
+		GpuParticlePool(GpuParticlePool&&) = delete;
+		GpuParticlePool& operator = (GpuParticlePool&&) = delete;
+
+		virtual bool create(RenderTarget& renderTarget, uint32_t poolSize);
+		virtual void destroy();
+
+		virtual void emit(const Particle& particle) override;
+		virtual void update(float deltaTime) override;
+		virtual void draw(BatchRenderer& renderer, const glm::mat4& rootTransform) override;
+		virtual void draw(const RenderPass& renderPass, const glm::mat4& viewProj, const glm::mat4& rootTransform);
+
+	protected:
+
+		virtual bool createComputeContext();
+		virtual bool createRenderContext(RenderTarget& renderTarget);
+		virtual bool createSlotContext(uint32_t slot, Texture* texture);
+		virtual bool uploadFrames();
+		virtual uint32_t getSlot(Texture* texture);
+
+	protected:
+
+		ComputeContext mComputeContext;
+		RenderContext mRenderContext;
+		std::vector<SlotContext> mSlots;
+		std::vector<GpuParticle> mEmitted;
+		std::vector<uint32_t> mFrameSlots;
+		uint32_t mEmittedCapacity{ 0 };
+		uint32_t mNumUploadedFrames{ 0 };
+		uint32_t mSrc{ 0 };
+		bool mReadbackPending{ false };
+	};
+}
\ No newline at end of file
@@ -9,9 +9,12 @@
 
 namespace Trinity
 {
-	class Particle;
+	struct Particle;
 	class ParticleEmitter;
 	class ParticlePool;
+	class GpuParticlePool;
+	class RenderTarget;
+	class RenderPass;
 	class BatchRenderer;
 	class ParticleEditor;
 	class ParticleSerializer;
@@ -39,6 +42,11 @@ namespace Trinity
 			return mTransform;
 		}
 
+		bool isGpuSimulated() const
+		{
+			return mGpuPool != nullptr;
+		}
+
 		virtual std::type_index getType() const;
 
 		virtual std::vector<ParticleEmitter*> getEmitters() const;
@@ -53,14 +61,18 @@ namespace Trinity
 		virtual void init(const glm::vec2& position, float rotation, 
 			uint32_t poolSize = kParticlePoolSize);
 
+		virtual bool enableGpuSimulation(RenderTarget& renderTarget);
+
 		virtual void setTransfrom(const glm::mat4& transform);
 		virtual void update(float deltaTime);
 		virtual void draw(BatchRenderer& batchRenderer);
+		virtual void draw(const RenderPass& renderPass, const glm::mat4& viewProj);
 
 	protected:
 
 		std::vector<std::unique_ptr<ParticleEmitter>> mEmitters;
 		std::unique_ptr<ParticlePool> mPool{ nullptr };
+		GpuParticlePool* mGpuPool{ nullptr };
 		glm::mat4 mTransform{ 1.0f };
 	};
 
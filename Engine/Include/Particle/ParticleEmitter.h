@@ -9,7 +9,7 @@
 namespace Trinity
 {
 	class Texture;
-	class Particle;
+	struct Particle;
 	class ParticlePool;
 	class ParticleEmitterEditor;
 	class ParticleEmitterSerializer;
@@ -1,18 +1,19 @@
 #pragma once
 
 #include "Particle/Particle.h"
+#include "Graphics/BatchRenderer.h"
 #include <memory>
 #include <vector>
 #include "glm/glm.hpp"
 
 namespace Trinity
 {
-	class BatchRenderer;
-
 	class ParticlePool
 	{
 	public:
 
+		static constexpr uint32_t kGrainSize = 16384;
+
 		ParticlePool() = default;
 		virtual ~ParticlePool() = default;
 
@@ -22,20 +23,83 @@ namespace Trinity
 		ParticlePool(ParticlePool&&) = default;
 		ParticlePool& operator = (ParticlePool&&) = default;
 
-		virtual Particle& getParticleSprite();
+		uint32_t getSize() const
+		{
+			return mNumParticles;
+		}
+
+		uint32_t getNumActive() const
+		{
+			return mNumActive;
+		}
+
+		const std::vector<Particle::TextureFrame>& getTextureFrames() const
+		{
+			return mTextureFrames;
+		}
+
+		const std::vector<uint32_t>& getFrames() const
+		{
+			return mFrames;
+		}
+
+		const std::vector<glm::vec2>& getPositions() const
+		{
+			return mPositions;
+		}
+
+		const std::vector<glm::vec4>& getColors() const
+		{
+			return mColors;
+		}
+
+		const std::vector<float>& getSizes() const
+		{
+			return mSizes;
+		}
+
+		const std::vector<float>& getRotations() const
+		{
+			return mRotations;
+		}
 
 		virtual void init(uint32_t poolSize);
+		virtual void emit(const Particle& particle);
 		virtual void update(float deltaTime);
 		virtual void draw(BatchRenderer& renderer, const glm::mat4& rootTransform);
 
 	protected:
 
 		virtual void resize(uint32_t newSize);
+		virtual uint32_t getFrameIndex(const Particle::TextureFrame& textureFrame);
+
+		virtual void integrate(uint32_t begin, uint32_t end, float deltaTimeSecs);
+		virtual void interpolate(uint32_t begin, uint32_t end);
+		virtual void writeVertices(uint32_t begin, uint32_t end, const Particle::TextureFrame& textureFrame,
+			const glm::mat4& rootTransform, BatchRenderer::Vertex* vertices);
+		virtual void compact();
+		virtual void move(uint32_t from, uint32_t to);
 
 	protected:
 
 		uint32_t mNumParticles{ 0 };
 		uint32_t mNumActive{ 0 };
-		std::vector<Particle> mParticleSprites;
+		std::vector<Particle::TextureFrame> mTextureFrames;
+		std::vector<uint32_t> mFrames;
+		std::vector<glm::vec2> mPositions;
+		std::vector<glm::vec2> mVelocities;
+		std::vector<glm::vec2> mAccelerations;
+		std::vector<glm::vec4> mStartColors;
+		std::vector<glm::vec4> mFinalColors;
+		std::vector<glm::vec4> mColors;
+		std::vector<float> mStartSizes;
+		std::vector<float> mFinalSizes;
+		std::vector<float> mSizes;
+		std::vector<float> mStartRotations;
+		std::vector<float> mFinalRotations;
+		std::vector<float> mRotations;
+		std::vector<float> mDrags;
+		std::vector<float> mInvLifeSpans;
+		std::vector<float> mLifeRemaining;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Math/BoundingRect.h"
+#include <cstdint>
+#include <vector>
+
+namespace Trinity
+{
+	struct BroadPhasePair
+	{
+		uint32_t first{ 0 };
+		uint32_t second{ 0 };
+	};
+
+	class BroadPhase
+	{
+	public:
+
+		static constexpr uint32_t kNullProxy = 0xffffffff;
+
+		BroadPhase() = default;
+		virtual ~BroadPhase() = default;
+
+		BroadPhase(const BroadPhase&) = delete;
+		BroadPhase& operator = (const BroadPhase&) = delete;
+
+		BroadPhase(BroadPhase&&) = default;
+		BroadPhase& operator = (BroadPhase&&) = default;
+
+		virtual uint32_t createProxy(const BoundingRect& bounds, void* userData) = 0;
+		virtual void destroyProxy(uint32_t proxyId) = 0;
+		virtual void moveProxy(uint32_t proxyId, const BoundingRect& bounds) = 0;
+		virtual void* getUserData(uint32_t proxyId) const = 0;
+		virtual void clear() = 0;
+		virtual void findPairs(std::vector<BroadPhasePair>& pairs) = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Physics/BroadPhase.h"
+
+namespace Trinity
+{
+	class DynamicTreeBroadPhase : public BroadPhase
+	{
+	public:
+
+		struct TreeNode
+		{
+			bool isLeaf() const
+			{
+				return child1 == kNullProxy;
+			}
+
+			BoundingRect bounds;
+			BoundingRect tightBounds;
+			void* userData{ nullptr };
+			uint32_t parent{ kNullProxy };
+			uint32_t child1{ kNullProxy };
+			uint32_t child2{ kNullProxy };
+			int32_t height{ -1 };
+		};
+
+		DynamicTreeBroadPhase() = default;
+		virtual ~DynamicTreeBroadPhase() = default;
+
+		DynamicTreeBroadPhase(const DynamicTreeBroadPhase&) = delete;
+		DynamicTreeBroadPhase& operator = (const DynamicTreeBroadPhase&) = delete;
+
+		DynamicTreeBroadPhase(DynamicTreeBroadPhase&&) = default;
+		DynamicTreeBroadPhase& operator = (DynamicTreeBroadPhase&&) = default;
+
+		float getMargin() const
+		{
+			return mMargin;
+		}
+
+		int32_t getHeight() const
+		{
+			return mRoot != kNullProxy ? mNodes[mRoot].height : 0;
+		}
+
+		virtual uint32_t createProxy(const BoundingRect& bounds, void* userData) override;
+		virtual void destroyProxy(uint32_t proxyId) override;
+		virtual void moveProxy(uint32_t proxyId, const BoundingRect& bounds) override;
+		virtual void* getUserData(uint32_t proxyId) const override;
+		virtual void clear() override;
+		virtual void findPairs(std::vector<BroadPhasePair>& pairs) override;
+		virtual void query(const BoundingRect& area, std::vector<uint32_t>& proxies);
+
+		virtual void setMargin(float margin);
+
+	protected:
+
+		virtual uint32_t allocateNode();
+		virtual void freeNode(uint32_t nodeId);
+		virtual void insertLeaf(uint32_t leaf);
+		virtual void removeLeaf(uint32_t leaf);
+		virtual uint32_t balance(uint32_t nodeId);
+		virtual BoundingRect getFatBounds(const BoundingRect& bounds) const;
+
+	protected:
+
+		float mMargin{ 4.0f };
+		uint32_t mRoot{ kNullProxy };
+		uint32_t mFreeList{ kNullProxy };
+		std::vector<TreeNode> mNodes;
+		std::vector<BroadPhasePair> mTraversePairs;
+		std::vector<uint32_t> mTraverseNodes;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Physics/BroadPhase.h"
+
+namespace Trinity
+{
+	class SortAndSweepBroadPhase : public BroadPhase
+	{
+	public:
+
+		struct Proxy
+		{
+			BoundingRect bounds;
+			void* userData{ nullptr };
+			bool active{ false };
+		};
+
+		struct SweepEntry
+		{
+			float minX{ 0.0f };
+			float maxX{ 0.0f };
+			float minY{ 0.0f };
+			float maxY{ 0.0f };
+			uint32_t proxyId{ kNullProxy };
+		};
+
+		SortAndSweepBroadPhase() = default;
+		virtual ~SortAndSweepBroadPhase() = default;
+
+		SortAndSweepBroadPhase(const SortAndSweepBroadPhase&) = delete;
+		SortAndSweepBroadPhase& operator = (const SortAndSweepBroadPhase&) = delete;
+
+		SortAndSweepBroadPhase(SortAndSweepBroadPhase&&) = default;
+		SortAndSweepBroadPhase& operator = (SortAndSweepBroadPhase&&) = default;
+
+		virtual uint32_t createProxy(const BoundingRect& bounds, void* userData) override;
+		virtual void destroyProxy(uint32_t proxyId) override;
+		virtual void moveProxy(uint32_t proxyId, const BoundingRect& bounds) override;
+		virtual void* getUserData(uint32_t proxyId) const override;
+		virtual void clear() override;
+		virtual void findPairs(std::vector<BroadPhasePair>& pairs) override;
+
+	protected:
+
+		virtual void sortEntries();
+
+	protected:
+
+		std::vector<Proxy> mProxies;
+		std::vector<uint32_t> mFreeProxies;
+		std::vector<SweepEntry> mEntries;
+	};
+}
\ No newline at end of file
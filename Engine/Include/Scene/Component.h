@@ -1,10 +1,15 @@
 #pragma once
 
 #include "Editor/Editor.h"
+#include "Scene/ComponentStorage.h"
+#include "Scene/ComponentPool.h"
 #include "VFS/Serializer.h"
+#include <cstddef>
 #include <memory>
+#include <new>
 #include <string>
 #include <typeindex>
+#include <utility>
 #include <vector>
 #include "uuid_v4.h"
 
@@ -46,21 +51,43 @@ namespace Trinity
 			return mActive;
 		}
 
+		const ComponentHandle& getHandle() const
+		{
+			return mHandle;
+		}
+
 		virtual IEditor* getEditor(Scene& scene);
 		virtual ISerializer* getSerializer(Scene& scene);
 
 		virtual void setName(const std::string& name);
 		virtual void setActive(bool active);
 		virtual void setNode(Node& node);
+		virtual void setHandle(const ComponentHandle& handle);
 
 		virtual std::type_index getType() const = 0;
 		virtual UUIDv4::UUID getTypeUUID() const = 0;
 
+	public:
+
+		template <typename T, typename... Args>
+		static std::unique_ptr<T> create(Args&&... args)
+		{
+			auto& pool = ComponentPool<T>::get();
+			auto* component = new (pool.allocate()) T(std::forward<Args>(args)...);
+			component->mPool = &pool;
+
+			return std::unique_ptr<T>(component);
+		}
+
+		static void operator delete(Component* ptr, std::destroying_delete_t);
+
 	protected:
 
 		std::string mName;
 		bool mActive{ true };
 		Node* mNode{ nullptr };
+		ComponentHandle mHandle;
+		IComponentPool* mPool{ nullptr };
 	};
 
 	class ComponentEditor : public IEditor
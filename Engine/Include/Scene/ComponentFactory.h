@@ -37,7 +37,7 @@ namespace Trinity
 		inline void registerCreator(const std::string& name)
 		{
 			registerCreator(T::UUID, name, []() {
-				return std::make_unique<T>();
+				return Component::create<T>();
 			});
 		}
 
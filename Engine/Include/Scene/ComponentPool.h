@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Trinity
+{
+	class IComponentPool
+	{
+	public:
+
+		IComponentPool() = default;
+		virtual ~IComponentPool() = default;
+
+		IComponentPool(const IComponentPool&) = delete;
+		IComponentPool& operator = (const IComponentPool&) = delete;
+
+		virtual void deallocate(void* ptr) = 0;
+	};
+
+	template <typename T>
+	class ComponentPool : public IComponentPool
+	{
+	public:
+
+		static constexpr uint32_t kSlotsPerChunk = 256;
+
+		union Slot
+		{
+			Slot* next;
+			alignas(T) std::byte storage[sizeof(T)];
+		};
+
+		ComponentPool() = default;
+		virtual ~ComponentPool() = default;
+
+		ComponentPool(const ComponentPool&) = delete;
+		ComponentPool& operator = (const ComponentPool&) = delete;
+
+		static ComponentPool& get()
+		{
+			static ComponentPool* pool = new ComponentPool();
+			return *pool;
+		}
+
+		uint32_t getNumAllocated() const
+		{
+			return mNumAllocated;
+		}
+
+		uint32_t getCapacity() const
+		{
+			return (uint32_t)mChunks.size() * kSlotsPerChunk;
+		}
+
+		void* allocate()
+		{
+			if (mFreeList == nullptr)
+			{
+				addChunk();
+			}
+
+			auto* slot = mFreeList;
+			mFreeList = slot->next;
+			mNumAllocated++;
+
+			return slot->storage;
+		}
+
+		virtual void deallocate(void* ptr) override
+		{
+			if (ptr == nullptr)
+			{
+				return;
+			}
+
+			auto* slot = static_cast<Slot*>(ptr);
+			slot->next = mFreeList;
+			mFreeList = slot;
+			mNumAllocated--;
+		}
+
+	private:
+
+		void addChunk()
+		{
+			auto chunk = std::make_unique<Slot[]>(kSlotsPerChunk);
+			for (uint32_t idx = kSlotsPerChunk; idx > 0; idx--)
+			{
+				auto* slot = &chunk[idx - 1];
+				slot->next = mFreeList;
+				mFreeList = slot;
+			}
+
+			mChunks.push_back(std::move(chunk));
+		}
+
+	private:
+
+		Slot* mFreeList{ nullptr };
+		uint32_t mNumAllocated{ 0 };
+		std::vector<std::unique_ptr<Slot[]>> mChunks;
+	};
+}
\ No newline at end of file
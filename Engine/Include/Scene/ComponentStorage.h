@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Trinity
+{
+	class Component;
+
+	struct ComponentHandle
+	{
+		static constexpr uint32_t kInvalidIndex = 0xffffffff;
+
+		bool isValid() const
+		{
+			return index != kInvalidIndex;
+		}
+
+		uint32_t index{ kInvalidIndex };
+		uint32_t generation{ 0 };
+	};
+
+	class ComponentStorage
+	{
+	public:
+
+		ComponentStorage() = default;
+		~ComponentStorage() = default;
+
+		ComponentStorage(const ComponentStorage&) = delete;
+		ComponentStorage& operator = (const ComponentStorage&) = delete;
+
+		ComponentStorage(ComponentStorage&&) = default;
+		ComponentStorage& operator = (ComponentStorage&&) = default;
+
+		const std::vector<std::unique_ptr<Component>>& getComponents() const
+		{
+			return mComponents;
+		}
+
+		uint32_t getSize() const
+		{
+			return (uint32_t)mComponents.size();
+		}
+
+		bool isEmpty() const
+		{
+			return mComponents.empty();
+		}
+
+		Component* getComponent(uint32_t denseIdx) const
+		{
+			return mComponents[denseIdx].get();
+		}
+
+		ComponentHandle getHandle(uint32_t denseIdx) const;
+		Component* getComponent(const ComponentHandle& handle) const;
+		bool contains(const ComponentHandle& handle) const;
+
+		ComponentHandle add(std::unique_ptr<Component> component);
+		std::unique_ptr<Component> remove(const ComponentHandle& handle);
+
+		void reserve(uint32_t size);
+		void clear();
+
+	private:
+
+		std::vector<std::unique_ptr<Component>> mComponents;
+		std::vector<uint32_t> mDenseToSparse;
+		std::vector<uint32_t> mSparse;
+		std::vector<uint32_t> mGenerations;
+		std::vector<uint32_t> mFreeIndices;
+	};
+}
\ No newline at end of file
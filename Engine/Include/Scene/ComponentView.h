@@ -0,0 +1,183 @@
+#pragma once
+
+#include "Scene/ComponentStorage.h"
+#include "Scene/Component.h"
+#include "Scene/Node.h"
+#include <array>
+#include <tuple>
+#include <typeindex>
+#include <type_traits>
+#include <utility>
+
+namespace Trinity
+{
+	template <typename... T>
+	class ComponentView
+	{
+	public:
+
+		static constexpr size_t kNumTypes = sizeof...(T);
+
+		using First = std::tuple_element_t<0, std::tuple<T...>>;
+		using Value = std::conditional_t<kNumTypes == 1, First&, std::tuple<T&...>>;
+		using Storages = std::array<const ComponentStorage*, kNumTypes>;
+		using Components = std::array<Component*, kNumTypes>;
+
+		class Iterator
+		{
+		public:
+
+			Iterator(const ComponentView& view, uint32_t index)
+				: mView(&view), mIndex(index)
+			{
+				next();
+			}
+
+			Value operator * () const
+			{
+				return mView->makeValue(mComponents, std::index_sequence_for<T...>{});
+			}
+
+			Iterator& operator ++ ()
+			{
+				mIndex++;
+				next();
+
+				return *this;
+			}
+
+			bool operator == (const Iterator& other) const
+			{
+				return mIndex == other.mIndex;
+			}
+
+			bool operator != (const Iterator& other) const
+			{
+				return mIndex != other.mIndex;
+			}
+
+		private:
+
+			void next()
+			{
+				while (mIndex < mView->mSize && !mView->fetch(mIndex, mComponents))
+				{
+					mIndex++;
+				}
+			}
+
+		private:
+
+			const ComponentView* mView{ nullptr };
+			uint32_t mIndex{ 0 };
+			Components mComponents{};
+		};
+
+	public:
+
+		ComponentView(const Storages& storages)
+			: mStorages(storages)
+		{
+			for (auto* storage : mStorages)
+			{
+				if (storage == nullptr)
+				{
+					continue;
+				}
+
+				if (mDriver == nullptr || storage->getSize() < mDriver->getSize())
+				{
+					mDriver = storage;
+				}
+			}
+
+			if (mDriver != nullptr)
+			{
+				mSize = mDriver->getSize();
+			}
+		}
+
+		Iterator begin() const
+		{
+			return Iterator(*this, 0);
+		}
+
+		Iterator end() const
+		{
+			return Iterator(*this, mSize);
+		}
+
+		template <typename Func>
+		void each(Func&& func) const
+		{
+			Components components{};
+			for (uint32_t idx = 0; idx < mSize; idx++)
+			{
+				if (fetch(idx, components))
+				{
+					invoke(func, components, std::index_sequence_for<T...>{});
+				}
+			}
+		}
+
+	private:
+
+		bool fetch(uint32_t index, Components& components) const
+		{
+			auto* component = mDriver->getComponent(index);
+			if constexpr (kNumTypes == 1)
+			{
+				components[0] = component;
+				return true;
+			}
+			else
+			{
+				auto* node = component->getNode();
+				for (size_t idx = 0; idx < kNumTypes; idx++)
+				{
+					if (mStorages[idx] == mDriver)
+					{
+						components[idx] = component;
+					}
+					else
+					{
+						components[idx] = node != nullptr ? node->findComponent(mTypes[idx]) : nullptr;
+					}
+
+					if (components[idx] == nullptr)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+		}
+
+		template <size_t... I>
+		Value makeValue(const Components& components, std::index_sequence<I...>) const
+		{
+			if constexpr (kNumTypes == 1)
+			{
+				return static_cast<First&>(*components[0]);
+			}
+			else
+			{
+				return std::tuple<T&...>(static_cast<T&>(*components[I])...);
+			}
+		}
+
+		template <typename Func, size_t... I>
+		void invoke(Func& func, const Components& components, std::index_sequence<I...>) const
+		{
+			func(static_cast<T&>(*components[I])...);
+		}
+
+	private:
+
+		Storages mStorages{};
+		std::array<std::type_index, kNumTypes> mTypes{ std::type_index(typeid(T))... };
+		const ComponentStorage* mDriver{ nullptr };
+		uint32_t mSize{ 0 };
+	};
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Scene/Component.h"
 #include "Scene/QuadTree.h"
+#include "Physics/BroadPhase.h"
 #include "Core/Observer.h"
 #include "Editor/Editor.h"
 #include "VFS/Serializer.h"
@@ -17,6 +18,8 @@ namespace Trinity
 	struct ColliderData : public QuadTreeData
 	{
 		Collider* collider{ nullptr };
+		uint32_t index{ 0 };
+		uint32_t proxyId{ BroadPhase::kNullProxy };
 	};
 
 	class Collider : public Component
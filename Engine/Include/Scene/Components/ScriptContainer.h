@@ -40,6 +40,7 @@ namespace Trinity
 		virtual Script& getScript(const UUIDv4::UUID& uuid);
 		virtual bool hasScript(const UUIDv4::UUID& uuid);
 		virtual void setScript(Script& script);
+		virtual void removeScript(Script& script);
 
 	public:
 
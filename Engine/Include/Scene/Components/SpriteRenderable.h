@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Scene/Component.h"
+#include "Graphics/BatchRenderer.h"
+#include "Math/BoundingRect.h"
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -9,9 +12,23 @@
 namespace Trinity
 {
 	class Sprite;
+	class Texture;
 
 	class SpriteRenderable : public Component
 	{
+	public:
+
+		struct QuadCache
+		{
+			std::array<BatchRenderer::Vertex, 4> vertices;
+			BoundingRect bounds;
+			Texture* texture{ nullptr };
+			glm::vec2 srcPosition{ 0.0f };
+			glm::vec2 srcSize{ 0.0f };
+			uint32_t worldVersion{ 0 };
+			bool valid{ false };
+		};
+
 	public:
 
 		SpriteRenderable() = default;
@@ -53,6 +70,16 @@ namespace Trinity
 			return mLayer;
 		}
 
+		uint32_t getCullProxyId() const
+		{
+			return mCullProxyId;
+		}
+
+		const QuadCache& getQuadCache() const
+		{
+			return mQuadCache;
+		}
+
 		virtual std::type_index getType() const override;
 		virtual UUIDv4::UUID getTypeUUID() const override;
 
@@ -61,6 +88,11 @@ namespace Trinity
 		virtual void setColor(const glm::vec4& color);
 		virtual void setFlip(const glm::bvec2& flip);
 		virtual void setActiveFrameIndex(uint32_t activeFrameIndex);
+		virtual void setLayer(uint32_t layer);
+		virtual void setCullProxyId(uint32_t cullProxyId);
+
+		virtual bool isQuadValid(uint32_t worldVersion) const;
+		virtual void updateQuad(const glm::mat4& worldMatrix, uint32_t worldVersion);
 
 	public:
 
@@ -74,5 +106,7 @@ namespace Trinity
 		glm::bvec2 mFlip{ false };
 		uint32_t mActiveFrameIndex{ 0 };
 		uint32_t mLayer{ 0 };
+		uint32_t mCullProxyId{ 0xffffffff };
+		QuadCache mQuadCache;
 	};
 }
\ No newline at end of file
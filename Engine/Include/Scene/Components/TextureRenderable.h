@@ -46,6 +46,11 @@ namespace Trinity
 			return mFlip;
 		}
 
+		uint32_t getCullProxyId() const
+		{
+			return mCullProxyId;
+		}
+
 		virtual std::type_index getType() const override;
 		virtual UUIDv4::UUID getTypeUUID() const override;
 
@@ -56,6 +61,7 @@ namespace Trinity
 		virtual void setOrigin(const glm::vec2& origin);
 		virtual void setColor(const glm::vec4& color);
 		virtual void setFlip(const glm::bvec2& flip);
+		virtual void setCullProxyId(uint32_t cullProxyId);
 
 	public:
 
@@ -67,6 +73,7 @@ namespace Trinity
 		glm::vec2 mOrigin{ 0.5f };
 		glm::vec4 mColor{ 0.0f };
 		glm::bvec2 mFlip{ false };
+		uint32_t mCullProxyId{ 0xffffffff };
 	};
 
 	class TextureRenderableEditor : public ComponentEditor
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Scene/Component.h"
+#include "Math/BoundingRect.h"
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Trinity
+{
+	class TileMap;
+	class TileLayer;
+	class RigidShape;
+	class RectangleShape;
+
+	class TileMapCollider : public Component
+	{
+	public:
+
+		static constexpr uint32_t kCellSize = 32;
+
+		struct Cell
+		{
+			std::vector<BoundingRect> bounds;
+			std::vector<std::unique_ptr<RectangleShape>> shapes;
+			bool dirty{ true };
+		};
+
+		TileMapCollider() = default;
+		virtual ~TileMapCollider();
+
+		TileMapCollider(const TileMapCollider&) = delete;
+		TileMapCollider& operator = (const TileMapCollider&) = delete;
+
+		TileMapCollider(TileMapCollider&&) = delete;
+		TileMapCollider& operator = (TileMapCollider&&) = delete;
+
+		TileMap* getTileMap() const
+		{
+			return mTileMap;
+		}
+
+		uint32_t getLayerIndex() const
+		{
+			return mLayerIdx;
+		}
+
+		const glm::vec2& getPosition() const
+		{
+			return mPosition;
+		}
+
+		uint32_t getLayers() const
+		{
+			return mLayers;
+		}
+
+		uint32_t getNumShapes() const
+		{
+			return mNumShapes;
+		}
+
+		virtual bool init();
+		virtual std::type_index getType() const override;
+		virtual UUIDv4::UUID getTypeUUID() const override;
+
+		virtual void setTileMap(TileMap& tileMap, uint32_t layerIdx);
+		virtual void setPosition(const glm::vec2& position);
+		virtual bool hasLayer(uint32_t layerIdx) const;
+		virtual void addLayer(uint32_t layerIdx);
+		virtual void removeLayer(uint32_t layerIdx);
+
+		virtual void invalidate();
+		virtual void invalidateTile(uint32_t tileIdx);
+		virtual void update();
+		virtual void query(const BoundingRect& area, std::vector<RigidShape*>& result) const;
+
+	public:
+
+		inline static UUIDv4::UUID UUID = UUIDv4::UUID::fromStrFactory("6f3c2d8e-41a7-4b59-9e0d-7a25c4f1b836");
+
+	protected:
+
+		virtual void detachTileMap();
+		virtual bool isSolid(uint32_t x, uint32_t y) const;
+		virtual void buildCell(uint32_t cellX, uint32_t cellY, Cell& cell);
+
+	protected:
+
+		TileMap* mTileMap{ nullptr };
+		const TileLayer* mTileLayer{ nullptr };
+		uint32_t mLayerIdx{ 0 };
+		uint32_t mLayerVersion{ 0 };
+		int32_t mTileChangedId{ -1 };
+		int32_t mDestroyedId{ -1 };
+		glm::vec2 mPosition{ 0.0f };
+		glm::vec2 mTileSize{ 0.0f };
+		glm::uvec2 mNumTiles{ 0 };
+		glm::uvec2 mNumCells{ 0 };
+		uint32_t mLayers{ 0 };
+		uint32_t mNumShapes{ 0 };
+		std::vector<Cell> mCells;
+		std::vector<uint8_t> mVisited;
+	};
+}
\ No newline at end of file
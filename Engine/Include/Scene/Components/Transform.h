@@ -11,6 +11,7 @@ namespace Trinity
 	class Node;
 	class TransformEditor;
 	class TransformSerializer;
+	class TransformHierarchy;
 
 	class Transform : public Component
 	{
@@ -18,6 +19,7 @@ namespace Trinity
 
 		friend class TransformEditor;
 		friend class TransformSerializer;
+		friend class TransformHierarchy;
 
 		Transform() = default;
 		virtual ~Transform() = default;
@@ -43,6 +45,16 @@ namespace Trinity
 			return mScale;
 		}
 
+		uint32_t getWorldVersion() const
+		{
+			return mWorldVersion;
+		}
+
+		TransformHierarchy* getHierarchy() const
+		{
+			return mHierarchy;
+		}
+
 		virtual std::type_index getType() const override;
 		virtual UUIDv4::UUID getTypeUUID() const override;
 
@@ -76,6 +88,10 @@ namespace Trinity
 		float mRotation{ 0.0f };
 		glm::vec2 mScale{ 1.0f };
 		glm::mat4 mWorldMatrix{ 1.0f };
+		uint32_t mWorldVersion{ 0 };
+		uint32_t mParentVersion{ 0 };
+		TransformHierarchy* mHierarchy{ nullptr };
+		uint32_t mHierarchyIndex{ 0xffffffff };
 
 	private:
 
@@ -71,8 +71,10 @@ namespace Trinity
 		virtual void addChild(Node& child);
 
 		virtual Component& getComponent(const std::type_index& type);
+		virtual Component* findComponent(const std::type_index& type);
 		virtual bool hasComponent(const std::type_index& type);
 		virtual void setComponent(Component& component);
+		virtual void removeComponent(Component& component);
 
 	public:
 
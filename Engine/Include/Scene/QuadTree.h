@@ -6,9 +6,13 @@
 
 namespace Trinity
 {
+	struct QuadTreeNode;
+
 	struct QuadTreeData
 	{
-		BoundingRect bounds;		
+		BoundingRect bounds;
+		std::vector<QuadTreeNode*> leaves;
+		uint32_t queryId{ 0 };
 	};
 
 	struct QuadTreeNode
@@ -19,6 +23,7 @@ namespace Trinity
 		}
 
 		BoundingRect bounds;
+		QuadTreeNode* parent{ nullptr };
 		std::vector<QuadTreeNode*> children;
 		std::vector<QuadTreeData*> contents;
 	};
@@ -44,15 +49,24 @@ namespace Trinity
 		virtual void create(const BoundingRect& minBounds, const BoundingRect& bounds);
 		virtual bool insert(QuadTreeData& data);
 		virtual void remove(QuadTreeData& data);
+		virtual void purge(std::vector<QuadTreeData*>& staleData);
+		virtual void clear();
 
 		virtual void update(QuadTreeData& data);
 		virtual void query(const BoundingRect& area, std::vector<QuadTreeData*>& result);
 
+	protected:
+
+		virtual bool insert(QuadTreeNode& start, QuadTreeData& data);
+		virtual void removeFromLeaves(QuadTreeData& data);
+
 	protected:
 
 		BoundingRect mMinBounds;
 		BoundingRect mBounds;
 		QuadTreeNode* mRoot{ nullptr };
+		uint32_t mQueryId{ 0 };
+		std::vector<QuadTreeNode*> mTraverseNodes;
 		std::vector<std::unique_ptr<QuadTreeNode>> mNodes;
 	};
 }
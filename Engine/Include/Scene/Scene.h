@@ -3,7 +3,10 @@
 #include "Core/Resource.h"
 #include <glm/glm.hpp>
 #include "Scene/Component.h"
+#include "Scene/ComponentStorage.h"
+#include "Scene/ComponentView.h"
 #include "Scene/Node.h"
+#include "Scene/TransformHierarchy.h"
 #include "Scene/Components/Light.h"
 #include "VFS/Serializer.h"
 #include <algorithm>
@@ -56,6 +59,11 @@ namespace Trinity
 			return mComponentFactory.get();
 		}
 
+		TransformHierarchy* getTransformHierarchy() const
+		{
+			return mTransformHierarchy.get();
+		}
+
 		virtual std::type_index getType() const override;
 		virtual void registerDefaultComponents();
 		virtual void clear();
@@ -66,7 +74,8 @@ namespace Trinity
 		virtual Node* findNode(const std::string& name) const;
 		virtual Node* findNode(const UUIDv4::UUID& uuid) const;
 
-		virtual const std::vector<std::unique_ptr<Component>>& getComponents(const std::type_index& type) const;
+		virtual const ComponentStorage& getComponents(const std::type_index& type) const;
+		virtual const ComponentStorage* getComponentStorage(const std::type_index& type) const;
 		virtual Component* getComponent(const std::type_index& type) const;
 
 		virtual void setNumLayers(uint32_t numLayers);
@@ -75,9 +84,11 @@ namespace Trinity
 		virtual void setNodes(std::vector<std::unique_ptr<Node>> nodes);
 		virtual void setRoot(Node& node);
 		virtual void updateNodeUUID(Node* node, const UUIDv4::UUID& newUUID);
+		virtual void updateTransforms();
 
 		virtual void addComponent(std::unique_ptr<Component> component);
 		virtual void addComponent(std::unique_ptr<Component> component, Node& node);
+		virtual std::unique_ptr<Component> removeComponent(Component& component);
 		virtual void setComponents(const std::type_index& type, std::vector<std::unique_ptr<Component>> components);
 
 		virtual Node* addEmpty(
@@ -161,22 +172,20 @@ namespace Trinity
 		std::vector<T*> getComponents() const
 		{
 			std::vector<T*> result;
-
-			if (hasComponent(typeid(T)))
+			for (auto& component : view<T>())
 			{
-				auto& sceneComponents = getComponents(typeid(T));
-
-				result.resize(sceneComponents.size());
-				std::transform(sceneComponents.begin(), sceneComponents.end(), result.begin(),
-					[](const auto& component) -> T* {
-						return dynamic_cast<T*>(component.get());
-					}
-				);
+				result.push_back(&component);
 			}
 
 			return result;
 		}
 
+		template <typename... T>
+		ComponentView<T...> view() const
+		{
+			return ComponentView<T...>({ getComponentStorage(typeid(T))... });
+		}
+
 		template <typename T>
 		T* getComponent() const
 		{
@@ -194,9 +203,10 @@ namespace Trinity
 		Node* mRoot{ nullptr };
 		uint32_t mNumLayers{ 0 };
 		std::unique_ptr<ComponentFactory> mComponentFactory{ nullptr };
+		std::unique_ptr<TransformHierarchy> mTransformHierarchy{ nullptr };
 		std::vector<std::unique_ptr<Node>> mNodes;
 		std::unordered_map<UUIDv4::UUID, Node*> mNodeMap;
-		std::unordered_map<std::type_index, std::vector<std::unique_ptr<Component>>> mComponents;
+		std::unordered_map<std::type_index, ComponentStorage> mComponents;
 	};
 
 	class SceneSerializer : public ISerializer
@@ -2,9 +2,13 @@
 
 #include "Core/Singleton.h"
 #include "Scene/QuadTree.h"
+#include "Physics/BroadPhase.h"
+#include "Physics/DynamicTreeBroadPhase.h"
 #include "Math/BoundingRect.h"
 #include <memory>
 #include <string>
+#include <vector>
+#include <functional>
 #include "glm/glm.hpp"
 
 namespace Trinity
@@ -17,14 +21,76 @@ namespace Trinity
 	class ResourceCache;
 	class Physics;
 	class Collider;
+	class RigidBody;
+	class RigidShape;
+	class TileMapCollider;
+	class SpriteRenderable;
+	class TextureRenderable;
 	struct ColliderData;
 
+	struct ColliderPair
+	{
+		uint32_t first{ 0 };
+		uint32_t second{ 0 };
+	};
+
 	class SceneSystem : public Singleton<SceneSystem>
 	{
 	public:
 
 		static constexpr const char* kTexturedShader = "/Assets/Engine/Shaders/Textured.wgsl";
 		static constexpr const char* kColoredShader = "/Assets/Engine/Shaders/Colored.wgsl";
+		static constexpr uint32_t kRigidBodyGrainSize = 64;
+		static constexpr uint32_t kIslandGrainSize = 4;
+		static constexpr uint32_t kSpriteGrainSize = 2048;
+
+		struct ColliderSlot
+		{
+			QuadTreeData* data{ nullptr };
+			uint32_t generation{ 0 };
+			uint64_t step{ 0 };
+		};
+
+		struct CullEntry
+		{
+			uint64_t frame{ 0 };
+			uint64_t visibleFrame{ 0 };
+			uint32_t order{ 0 };
+		};
+
+		struct CullContext
+		{
+			DynamicTreeBroadPhase tree;
+			std::vector<uint32_t> proxies;
+			std::vector<CullEntry> entries;
+			std::vector<uint32_t> visible;
+		};
+
+		struct RenderListEntry
+		{
+			uint32_t layer{ 0 };
+			uint32_t serial{ 0 };
+		};
+
+		struct RenderListItem
+		{
+			uint32_t proxyId{ 0 };
+			uint32_t serial{ 0 };
+		};
+
+		struct RenderBucket
+		{
+			uint32_t layer{ 0 };
+			std::vector<RenderListItem> items;
+		};
+
+		struct CullStats
+		{
+			uint32_t numVisibleTextures{ 0 };
+			uint32_t numCulledTextures{ 0 };
+			uint32_t numVisibleSprites{ 0 };
+			uint32_t numCulledSprites{ 0 };
+		};
 
 		SceneSystem() = default;
 		virtual ~SceneSystem() = default;
@@ -45,12 +111,23 @@ namespace Trinity
 			return mPhysics.get();
 		}
 
+		BroadPhase* getBroadPhase() const
+		{
+			return mBroadPhase.get();
+		}
+
+		const CullStats& getCullStats() const
+		{
+			return mCullStats;
+		}
+
 		virtual bool create(RenderTarget& renderTarget, ResourceCache& cache);
 		virtual void destroy();
 
 		virtual void setScene(Scene& scene);
 		virtual void setCamera(Camera& camera);
 		virtual void setCamera(const std::string& cameraNodeName);
+		virtual void setBroadPhase(std::unique_ptr<BroadPhase> broadPhase);
 		virtual void setupQuadTree(const BoundingRect& sceneBounds, const BoundingRect& minBounds);
 
 		virtual void update(float deltaTime);
@@ -59,9 +136,27 @@ namespace Trinity
 
 	protected:
 
+		virtual void trackCollider(Collider& collider);
+		virtual void detachCollider(Collider& collider);
+		virtual void sweepColliders();
 		virtual void updateQuadTree(Collider& collider);
-		virtual void queryColliders(Collider& collider, std::vector<Collider*>& colliders);
-		virtual void collision(Collider& collider);
+		virtual void updateBroadPhase(Collider& collider);
+		virtual void findPairs(std::vector<ColliderPair>& pairs);
+		virtual void addPair(Collider& collider1, Collider& collider2, std::vector<ColliderPair>& pairs);
+		virtual void buildIslands(const std::vector<ColliderPair>& pairs);
+		virtual void solveIsland(uint32_t island, const std::vector<ColliderPair>& pairs);
+		virtual void collision(const std::vector<ColliderPair>& pairs);
+		virtual void collideTileMaps();
+		virtual uint32_t findIsland(uint32_t index);
+		virtual void parallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& job);
+
+		virtual uint32_t updateCullProxy(CullContext& context, uint32_t proxyId, uint32_t order,
+			const BoundingRect& bounds, void* userData);
+
+		virtual void sweepCullProxies(CullContext& context);
+		virtual void queryCullProxies(CullContext& context, const BoundingRect& viewBounds);
+		virtual void updateRenderList(uint32_t proxyId, uint32_t layer, bool isNew);
+		virtual void collectRenderList(const CullContext& context, std::vector<SpriteRenderable*>& renderables);
 
 		virtual void drawTextures(const RenderPass& renderPass, const glm::mat4& viewProj);
 		virtual void drawSprites(const RenderPass& renderPass, const glm::mat4& viewProj);
@@ -73,5 +168,34 @@ namespace Trinity
 		std::unique_ptr<BatchRenderer> mRenderer{ nullptr };
 		std::unique_ptr<Physics> mPhysics{ nullptr };
 		std::unique_ptr<QuadTree> mQuadTree{ nullptr };
+		std::unique_ptr<BroadPhase> mBroadPhase{ nullptr };
+		std::vector<QuadTreeData*> mQueryResult;
+		std::vector<BroadPhasePair> mBroadPhasePairs;
+		std::vector<ColliderPair> mPairs;
+		std::vector<Collider*> mColliders;
+		std::vector<ColliderSlot> mColliderSlots;
+		std::vector<QuadTreeData*> mStaleColliders;
+		std::vector<uint32_t> mColliderProxies;
+		std::vector<uint64_t> mColliderProxySteps;
+		uint64_t mPhysicsStep{ 0 };
+		std::vector<RigidBody*> mRigidBodies;
+		std::vector<uint32_t> mIslandParents;
+		std::vector<uint32_t> mIslandIndices;
+		std::vector<uint32_t> mIslandOffsets;
+		std::vector<uint32_t> mIslandPairs;
+		std::vector<uint8_t> mPairHits;
+		std::vector<std::vector<Collider*>> mContacts;
+		std::vector<TileMapCollider*> mTileMapColliders;
+		std::vector<RigidShape*> mTileShapes;
+		std::vector<SpriteRenderable*> mSpriteRenderables;
+		CullContext mTextureCull;
+		CullContext mSpriteCull;
+		CullStats mCullStats;
+		uint64_t mCullFrame{ 0 };
+		std::vector<RenderBucket> mRenderBuckets;
+		std::vector<RenderListEntry> mRenderListEntries;
+		uint32_t mRenderListSerial{ 0 };
+		std::vector<SpriteRenderable*> mDirtySprites;
+		std::vector<glm::mat4> mSpriteTransforms;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Trinity
+{
+	class Node;
+	class Transform;
+
+	class TransformHierarchy
+	{
+	public:
+
+		static constexpr uint32_t kInvalidIndex = 0xffffffff;
+
+		TransformHierarchy() = default;
+		virtual ~TransformHierarchy() = default;
+
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator = (const TransformHierarchy&) = delete;
+
+		TransformHierarchy(TransformHierarchy&&) = default;
+		TransformHierarchy& operator = (TransformHierarchy&&) = default;
+
+		Node* getRoot() const
+		{
+			return mRoot;
+		}
+
+		uint32_t getSize() const
+		{
+			return (uint32_t)mTransforms.size();
+		}
+
+		bool isStructureDirty() const
+		{
+			return mStructureDirty;
+		}
+
+		bool hasPendingChanges() const
+		{
+			return mHasPendingChanges;
+		}
+
+		const std::vector<glm::mat4>& getWorldMatrices() const
+		{
+			return mWorldMatrices;
+		}
+
+		virtual void setRoot(Node* root);
+		virtual void clear();
+		virtual void update();
+
+		virtual bool invalidate(uint32_t index);
+		virtual void invalidateStructure();
+
+	protected:
+
+		virtual void rebuild();
+		virtual void updateRange(uint32_t begin, uint32_t end);
+
+	protected:
+
+		Node* mRoot{ nullptr };
+		bool mStructureDirty{ true };
+		bool mHasPendingChanges{ false };
+		std::vector<Transform*> mTransforms;
+		std::vector<uint32_t> mParents;
+		std::vector<uint32_t> mSubtreeEnds;
+		std::vector<uint8_t> mDirty;
+		std::vector<glm::mat4> mWorldMatrices;
+		std::vector<std::pair<Node*, uint32_t>> mTraverseNodes;
+	};
+}
\ No newline at end of file
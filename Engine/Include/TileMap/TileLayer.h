@@ -11,6 +11,12 @@ namespace Trinity
 {
 	class TileLayerSerializer;
 
+	enum class TileLayerStorage : uint32_t
+	{
+		Dense,
+		Sparse
+	};
+
 	struct TileObject
 	{
 		glm::vec2 position;
@@ -24,6 +30,11 @@ namespace Trinity
 
 		friend class TileLayerSerializer;
 
+		static constexpr uint32_t kSparseChunkSize = 64;
+		static constexpr uint32_t kSparseMarker = 0xffffffff;
+		static constexpr uint32_t kVersionMarker = 0xfffffffe;
+		static constexpr uint32_t kVersion = 2;
+
 		TileLayer() = default;
 		virtual ~TileLayer() = default;
 
@@ -38,11 +49,6 @@ namespace Trinity
 			return mName;
 		}
 
-		const std::vector<uint32_t>& getData() const
-		{
-			return mData;
-		}
-
 		const std::vector<TileObject>& getObjects() const
 		{
 			return mObjects;
@@ -53,23 +59,68 @@ namespace Trinity
 			return mVisible;
 		}
 
+		const glm::vec2& getOffset() const
+		{
+			return mOffset;
+		}
+
+		const glm::vec2& getParallax() const
+		{
+			return mParallax;
+		}
+
+		uint32_t getVersion() const
+		{
+			return mVersion;
+		}
+
+		TileLayerStorage getStorage() const
+		{
+			return mStorage;
+		}
+
+		const glm::uvec2& getNumTiles() const
+		{
+			return mNumTiles;
+		}
+
 		virtual ISerializer* getSerializer();
-		virtual uint32_t getTile(uint32_t index);
+		virtual uint32_t getSize() const;
+		virtual uint32_t getTile(uint32_t index) const;
+		virtual std::vector<uint32_t> getDenseData() const;
 
 		virtual void setName(const std::string& name);
 		virtual void setData(std::vector<uint32_t>&& data);
 		virtual void setObjects(std::vector<TileObject>&& objects);
 		virtual void setTile(uint32_t index, uint32_t id);
 		virtual void setVisible(bool visible);
+		virtual void setOffset(const glm::vec2& offset);
+		virtual void setParallax(const glm::vec2& parallax);
 		virtual void toggleVisibility();
-		virtual void resize(uint32_t newSize);
+		virtual void resize(uint32_t width, uint32_t height);
+		virtual void setStorage(TileLayerStorage storage);
+
+	protected:
+
+		virtual uint32_t getSparseTile(uint32_t x, uint32_t y) const;
+		virtual void setSparseTile(uint32_t x, uint32_t y, uint32_t id);
+		virtual void setSparseData(const std::vector<uint32_t>& data);
+		virtual void setDenseSize(uint32_t size);
 
 	protected:
 
 		std::string mName;
 		std::vector<uint32_t> mData;
+		std::vector<std::vector<uint32_t>> mSparseChunks;
+		std::vector<uint32_t> mSparseCounts;
+		glm::uvec2 mNumSparseChunks{ 0 };
+		glm::uvec2 mNumTiles{ 0 };
+		TileLayerStorage mStorage{ TileLayerStorage::Dense };
 		std::vector<TileObject> mObjects;
+		glm::vec2 mOffset{ 0.0f };
+		glm::vec2 mParallax{ 1.0f };
 		bool mVisible{ true };
+		uint32_t mVersion{ 0 };
 	};
 
 	class TileLayerSerializer : public ISerializer
@@ -92,6 +143,9 @@ namespace Trinity
 		virtual bool read(json& object, ResourceCache& cache) override;
 		virtual bool write(json& object) override;
 
+		virtual std::vector<uint32_t> encodeRuns(const std::vector<uint32_t>& tiles) const;
+		virtual bool decodeRuns(const std::vector<uint32_t>& runs, std::vector<uint32_t>& tiles) const;
+
 	protected:
 
 		virtual bool readTileObject(FileReader& reader, TileObject& tileObject);
@@ -100,6 +154,17 @@ namespace Trinity
 		virtual bool readTileObject(json& object, TileObject& tileObject);
 		virtual bool writeTileObject(json& object, const TileObject& tileObject);
 
+		virtual bool readSparseData(FileReader& reader, uint32_t version);
+		virtual bool readLegacySparseData(FileReader& reader);
+		virtual bool writeSparseData(FileWriter& writer);
+		virtual bool readSparseData(json& object);
+		virtual bool readLegacySparseData(json& object);
+		virtual bool writeSparseData(json& object);
+		virtual bool readSparseChunk(uint32_t chunkX, uint32_t chunkY, const std::vector<uint32_t>& runs, 
+			std::vector<uint32_t>& tiles);
+		virtual bool readLegacySparseChunk(uint32_t chunkIdx, const std::vector<uint32_t>& runs, 
+			std::vector<uint32_t>& tiles, std::vector<uint32_t>& data);
+
 	protected:
 
 		TileLayer* mTileLayer{ nullptr };
@@ -3,6 +3,8 @@
 #include "Core/Resource.h"
 #include "Editor/Editor.h"
 #include "VFS/Serializer.h"
+#include "Graphics/BatchRenderer.h"
+#include "Core/Observer.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -13,7 +15,7 @@ namespace Trinity
 {
 	class TileSet;
 	class TileLayer;
-	class BatchRenderer;
+	class Texture;
 	class TileMapEditor;
 	class TileMapSerializer;
 
@@ -24,8 +26,37 @@ namespace Trinity
 		friend class TileMapEditor;
 		friend class TileMapSerializer;
 
+		static constexpr uint32_t kChunkSize = 16;
+
+		struct TileInfo
+		{
+			TileSet* tileSet{ nullptr };
+			glm::vec2 srcPosition{ 0.0f };
+		};
+
+		struct ChunkBatch
+		{
+			Texture* texture{ nullptr };
+			uint32_t firstQuad{ 0 };
+			uint32_t numQuads{ 0 };
+		};
+
+		struct TileChunk
+		{
+			std::vector<BatchRenderer::Vertex> vertices;
+			std::vector<ChunkBatch> batches;
+			bool dirty{ true };
+		};
+
+		struct LayerChunks
+		{
+			const TileLayer* tileLayer{ nullptr };
+			uint32_t version{ 0 };
+			std::vector<TileChunk> chunks;
+		};
+
 		TileMap() = default;
-		virtual ~TileMap() = default;
+		virtual ~TileMap();
 
 		TileMap(const TileMap&) = delete;
 		TileMap& operator = (const TileMap&) = delete;
@@ -69,7 +100,9 @@ namespace Trinity
 		virtual uint32_t getTile(uint32_t layerIdx, uint32_t tileIdx) const;
 		virtual uint32_t getTile(uint32_t layerIdx, uint32_t x, uint32_t y) const;
 		virtual TileSet* getTileSet(uint32_t index) const;
+		virtual TileLayer* getTileLayer(uint32_t index) const;
 		virtual TileSet* getTileSetFromId(uint32_t tileId) const;
+		virtual const TileInfo* getTileInfo(uint32_t tileId) const;
 		virtual uint32_t getNextTileSetId() const;
 
 		virtual void setTile(uint32_t layerIdx, uint32_t tileIdx, uint32_t tileId);
@@ -85,9 +118,26 @@ namespace Trinity
 		virtual void moveTileSet(uint32_t from, uint32_t to);
 		virtual void moveTileLayer(uint32_t from, uint32_t to);
 
+		virtual void invalidateChunks();
+		virtual bool getVisibleTiles(const glm::vec2& position, float left, float bottom, float right, float top,
+			glm::uvec2& beginTile, glm::uvec2& endTile) const;
+
 		virtual void draw(BatchRenderer& batchRenderer, const glm::vec2& position, 
 			float left, float bottom, float right, float top);
 
+	public:
+
+		Observer<uint32_t, uint32_t> onTileChanged;
+		Observer<> onDestroyed;
+
+	protected:
+
+		virtual void buildTileInfos();
+		virtual glm::uvec2 getNumChunks() const;
+		virtual LayerChunks& getLayerChunks(uint32_t layerIdx);
+		virtual void buildChunk(const TileLayer& tileLayer, uint32_t chunkX, uint32_t chunkY, TileChunk& chunk);
+		virtual void drawChunk(BatchRenderer& batchRenderer, const glm::vec2& position, const TileChunk& chunk);
+
 	protected:
 
 		glm::vec2 mTileSize{ 0.0f };
@@ -95,6 +145,10 @@ namespace Trinity
 		glm::uvec2 mNumTiles{ 0 };
 		std::vector<std::unique_ptr<TileSet>> mTileSets;
 		std::vector<std::unique_ptr<TileLayer>> mTileLayers;
+		std::vector<TileInfo> mTileInfos;
+		std::vector<LayerChunks> mLayerChunks;
+		std::vector<std::pair<Texture*, uint32_t>> mChunkTiles;
+		uint32_t mTileSetVersion{ 0 };
 	};
 
 	class TileMapEditor : public IEditor
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Core/JobSystem.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Trinity
+{
+	class TileMap;
+
+	class TileMapStreamer
+	{
+	public:
+
+		static constexpr uint32_t kRegionSize = 64;
+		static constexpr const char* kRegionExtension = ".region";
+
+		enum class RegionState
+		{
+			Unloaded,
+			Loading,
+			Loaded
+		};
+
+		struct Region
+		{
+			RegionState state{ RegionState::Unloaded };
+			JobHandle job{ nullptr };
+			std::vector<std::vector<uint32_t>> layers;
+			size_t memory{ 0 };
+			bool failed{ false };
+		};
+
+		TileMapStreamer() = default;
+		virtual ~TileMapStreamer();
+
+		TileMapStreamer(const TileMapStreamer&) = delete;
+		TileMapStreamer& operator = (const TileMapStreamer&) = delete;
+
+		TileMapStreamer(TileMapStreamer&&) = default;
+		TileMapStreamer& operator = (TileMapStreamer&&) = default;
+
+		const glm::uvec2& getNumRegions() const
+		{
+			return mNumRegions;
+		}
+
+		uint32_t getNumResident() const
+		{
+			return (uint32_t)mResident.size();
+		}
+
+		size_t getMemoryUsage() const
+		{
+			return mMemoryUsage;
+		}
+
+		float getLoadRadius() const
+		{
+			return mLoadRadius;
+		}
+
+		float getUnloadRadius() const
+		{
+			return mUnloadRadius;
+		}
+
+		size_t getMemoryBudget() const
+		{
+			return mMemoryBudget;
+		}
+
+		virtual bool create(TileMap& tileMap, const std::string& path);
+		virtual void destroy();
+
+		virtual void setLoadRadius(float loadRadius);
+		virtual void setUnloadRadius(float unloadRadius);
+		virtual void setMemoryBudget(size_t memoryBudget);
+
+		virtual void update(const glm::vec2& position, const glm::vec2& center);
+
+		static bool writeRegions(TileMap& tileMap, const std::string& path);
+
+	protected:
+
+		virtual size_t getRegionMemory(uint32_t regionIdx) const;
+		virtual size_t getLayerMemory(uint32_t regionIdx) const;
+		virtual float getRegionDistance(uint32_t regionIdx, const glm::vec2& center) const;
+
+		virtual void loadRegion(uint32_t regionIdx);
+		virtual void applyRegion(uint32_t regionIdx);
+		virtual void unloadRegion(uint32_t regionIdx);
+		virtual void writeTiles(uint32_t regionIdx, const std::vector<std::vector<uint32_t>>* layers);
+
+		static std::string getRegionPath(const std::string& path, uint32_t x, uint32_t y);
+		static bool readRegion(const std::string& path, uint32_t numTiles, Region& region);
+
+	protected:
+
+		TileMap* mTileMap{ nullptr };
+		std::string mPath;
+		glm::uvec2 mNumRegions{ 0 };
+		std::vector<Region> mRegions;
+		std::vector<uint32_t> mResident;
+		float mLoadRadius{ 1024.0f };
+		float mUnloadRadius{ 1536.0f };
+		size_t mMemoryBudget{ 64 * 1024 * 1024 };
+		size_t mMemoryUsage{ 0 };
+	};
+}
\ No newline at end of file
@@ -60,6 +60,11 @@ namespace Trinity
 			return mFirstId;
 		}
 
+		uint32_t getVersion() const
+		{
+			return mVersion;
+		}
+
 		Texture* getTexture() const
 		{
 			return mTexture;
@@ -101,6 +106,7 @@ namespace Trinity
 		float mSpacing{ 0.0f };
 		uint32_t mFirstId{ 0 };
 		Texture* mTexture{ nullptr };
+		uint32_t mVersion{ 0 };
 		std::unordered_map<uint32_t, std::unordered_map<std::string, 
 			std::string>> mProperties;
 	};
@@ -2,6 +2,7 @@
 #include "Core/Logger.h"
 #include "Core/Debugger.h"
 #include "Core/Clock.h"
+#include "Core/JobSystem.h"
 #include "Core/Window.h"
 #include "Core/ResourceCache.h"
 #include "VFS/FileSystem.h"
@@ -12,6 +13,7 @@
 #include "Graphics/SwapChain.h"
 #include "Graphics/RenderPass.h"
 #include <iostream>
+#include <algorithm>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -51,6 +53,7 @@ namespace Trinity
 
 		mDebugger = std::make_unique<Debugger>();
 		mClock = std::make_unique<Clock>();
+		mJobSystem = std::make_unique<JobSystem>();
 		mFileSystem = std::make_unique<FileSystem>();
 		mInput = std::make_unique<Input>();
 		mWindow = std::make_unique<Window>();
@@ -62,6 +65,10 @@ namespace Trinity
 			return;
 		}
 
+#ifndef __EMSCRIPTEN__
+		mJobSystem->create(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+#endif
+
 #ifdef __EMSCRIPTEN__
 		mOptions.width = getCanvasWidth();
 		mOptions.height = getCanvasHeight();
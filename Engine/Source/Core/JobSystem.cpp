@@ -0,0 +1,269 @@
+#include "Core/JobSystem.h"
+#include <algorithm>
+
+namespace Trinity
+{
+	static thread_local uint32_t sThreadIndex{ 0 };
+
+	JobSystem::~JobSystem()
+	{
+		destroy();
+	}
+
+	uint32_t JobSystem::getThreadIndex()
+	{
+		return sThreadIndex;
+	}
+
+	bool JobSystem::create(uint32_t numWorkers)
+	{
+		destroy();
+
+		mRunning = true;
+		mQueues.resize(numWorkers + 1);
+
+		for (auto& queue : mQueues)
+		{
+			queue = std::make_unique<WorkerQueue>();
+		}
+
+		mWorkers.reserve(numWorkers);
+		for (uint32_t idx = 0; idx < numWorkers; idx++)
+		{
+			mWorkers.emplace_back([this, idx]() {
+				execute(idx + 1);
+			});
+		}
+
+		return true;
+	}
+
+	void JobSystem::destroy()
+	{
+		{
+			std::lock_guard lock(mMutex);
+			mRunning = false;
+		}
+
+		mCondition.notify_all();
+
+		for (auto& worker : mWorkers)
+		{
+			worker.join();
+		}
+
+		mWorkers.clear();
+		mQueues.clear();
+		mNumQueued = 0;
+	}
+
+	JobHandle JobSystem::schedule(Job job)
+	{
+		return schedule(std::move(job), {});
+	}
+
+	JobHandle JobSystem::schedule(Job job, const std::vector<JobHandle>& dependencies)
+	{
+		auto handle = std::make_shared<JobTask>();
+		handle->job = std::move(job);
+
+		for (auto& dependency : dependencies)
+		{
+			std::lock_guard lock(dependency->mutex);
+			if (!dependency->finished)
+			{
+				handle->numDependencies++;
+				dependency->continuations.push_back(handle);
+			}
+		}
+
+		if (handle->numDependencies.fetch_sub(1) == 1)
+		{
+			push([this, handle]() {
+				handle->job();
+				finish(handle);
+			});
+		}
+
+		return handle;
+	}
+
+	void JobSystem::wait(const JobHandle& handle)
+	{
+		while (!handle->finished.load(std::memory_order_acquire))
+		{
+			if (!runJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::wait(const std::vector<JobHandle>& handles)
+	{
+		for (auto& handle : handles)
+		{
+			wait(handle);
+		}
+	}
+
+	void JobSystem::parallelFor(uint32_t count, uint32_t grainSize, const RangeJob& job)
+	{
+		grainSize = std::max(grainSize, 1u);
+
+		if (mWorkers.empty() || count <= grainSize)
+		{
+			if (count > 0)
+			{
+				job(0, count);
+			}
+
+			return;
+		}
+
+		const auto numChunks = (count + grainSize - 1) / grainSize;
+		std::atomic<uint32_t> remaining{ numChunks - 1 };
+
+		for (uint32_t chunk = 1; chunk < numChunks; chunk++)
+		{
+			auto begin = chunk * grainSize;
+			auto end = std::min(begin + grainSize, count);
+
+			push([&job, &remaining, begin, end]() {
+				job(begin, end);
+				remaining.fetch_sub(1, std::memory_order_release);
+			});
+		}
+
+		job(0, std::min(grainSize, count));
+
+		while (remaining.load(std::memory_order_acquire) > 0)
+		{
+			if (!runJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::execute(uint32_t threadIndex)
+	{
+		sThreadIndex = threadIndex;
+
+		while (true)
+		{
+			if (runJob())
+			{
+				continue;
+			}
+
+			std::unique_lock lock(mMutex);
+			mCondition.wait(lock, [this]() {
+				return !mRunning || mNumQueued.load() > 0;
+			});
+
+			if (!mRunning)
+			{
+				return;
+			}
+		}
+	}
+
+	void JobSystem::push(Job job)
+	{
+		if (mWorkers.empty())
+		{
+			job();
+			return;
+		}
+
+		{
+			std::lock_guard lock(mMutex);
+			mNumQueued++;
+		}
+
+		auto& queue = *mQueues[sThreadIndex < mQueues.size() ? sThreadIndex : 0];
+		{
+			std::lock_guard lock(queue.mutex);
+			queue.jobs.push_back(std::move(job));
+		}
+
+		mCondition.notify_one();
+	}
+
+	bool JobSystem::pop(Job& job)
+	{
+		auto& queue = *mQueues[sThreadIndex < mQueues.size() ? sThreadIndex : 0];
+		std::lock_guard lock(queue.mutex);
+
+		if (queue.jobs.empty())
+		{
+			return false;
+		}
+
+		job = std::move(queue.jobs.back());
+		queue.jobs.pop_back();
+		mNumQueued--;
+
+		return true;
+	}
+
+	bool JobSystem::steal(Job& job)
+	{
+		const auto numQueues = (uint32_t)mQueues.size();
+		for (uint32_t idx = 1; idx < numQueues; idx++)
+		{
+			auto& queue = *mQueues[(sThreadIndex + idx) % numQueues];
+			std::lock_guard lock(queue.mutex);
+
+			if (!queue.jobs.empty())
+			{
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+				mNumQueued--;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool JobSystem::runJob()
+	{
+		if (mQueues.empty())
+		{
+			return false;
+		}
+
+		Job job;
+		if (pop(job) || steal(job))
+		{
+			job();
+			return true;
+		}
+
+		return false;
+	}
+
+	void JobSystem::finish(const JobHandle& handle)
+	{
+		std::vector<JobHandle> continuations;
+		{
+			std::lock_guard lock(handle->mutex);
+			handle->finished.store(true, std::memory_order_release);
+			continuations = std::move(handle->continuations);
+		}
+
+		for (auto& continuation : continuations)
+		{
+			if (continuation->numDependencies.fetch_sub(1) == 1)
+			{
+				push([this, continuation]() {
+					continuation->job();
+					finish(continuation);
+				});
+			}
+		}
+	}
+}
\ No newline at end of file
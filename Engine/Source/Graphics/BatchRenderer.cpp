@@ -18,6 +18,8 @@
 #include "Core/Debugger.h"
 #include "Core/ResourceCache.h"
 #include "glm/gtx/matrix_decompose.hpp"
+#include "glm/gtc/packing.hpp"
+#include <algorithm>
 
 namespace Trinity
 {
@@ -69,12 +71,19 @@ namespace Trinity
 
 	void BatchRenderer::destroy()
 	{
+		if (mResourceCache == nullptr)
+		{
+			return;
+		}
+
 		mResourceCache->removeResource(mRenderContext.texturedShader);
 		mResourceCache->removeResource(mRenderContext.coloredShader);
 		mResourceCache->removeResource(mRenderContext.texturedPipeline);
 		mResourceCache->removeResource(mRenderContext.coloredPipeline);
 		mResourceCache->removeResource(mRenderContext.vertexLayout);
 		mResourceCache->removeResource(mRenderContext.vertexBuffer);
+		mResourceCache->removeResource(mRenderContext.slotLayout);
+		mResourceCache->removeResource(mRenderContext.slotBuffer);
 		mResourceCache->removeResource(mRenderContext.indexBuffer);
 		mResourceCache->removeResource(mRenderContext.perFrameBuffer);
 		mResourceCache->removeResource(mRenderContext.bindGroup);
@@ -82,74 +91,165 @@ namespace Trinity
 
 		mRenderContext = {};
 		mStagingContext = {};
+		mVertexRing = {};
 		mResourceCache = nullptr;
 	}
 
 	void BatchRenderer::begin(const glm::mat4& viewProj)
 	{
+		mViewProj = viewProj;
 		updatePerFrameBuffer(viewProj);
 	}
 
 	void BatchRenderer::end(const RenderPass& renderPass)
 	{
-		auto* vertexBuffer = mRenderContext.vertexBuffer;
-		if (vertexBuffer->getNumVertices() < mStagingContext.numVertices)
+		if (mNumShards > 0 && !mergeShards())
+		{
+			LogError("BatchRenderer::mergeShards() failed");
+		}
+
+		if (mSortMode == BatchSortMode::Texture && mCommands.size() > 1)
+		{
+			sortCommands();
+		}
+
+		if (mTextureMode == BatchTextureMode::Array)
+		{
+			buildTextureSets();
+		}
+
+		const auto numVertices = mStagingContext.numVertices;
+		const auto frameIndex = GraphicsDevice::get().getFrameIndex();
+		const auto isInstanced = mVertexFormat == BatchVertexFormat::Instanced;
+
+		const void* data{ mStagingContext.vertices.data() };
+		uint32_t numElements{ numVertices };
+
+		if (mVertexFormat == BatchVertexFormat::Packed)
+		{
+			packVertices(numVertices);
+			data = mStagingContext.packedVertices.data();
+		}
+		else if (isInstanced)
+		{
+			packInstances(numVertices);
+			data = mStagingContext.instances.data();
+			numElements = numVertices / 4;
+		}
+
+		advanceRing(mVertexRing, frameIndex);
+
+		uint32_t baseElement{ 0 };
+		if (!allocateRing(mVertexRing, numElements, baseElement))
 		{
-			vertexBuffer->destroy();
-			if (!vertexBuffer->create(*mRenderContext.vertexLayout, mStagingContext.numVertices))
+			if (!growVertexBuffer(numElements))
+			{
+				LogError("BatchRenderer::growVertexBuffer() failed");
+				resetFrame();
+				return;
+			}
+
+			if (!allocateRing(mVertexRing, numElements, baseElement))
 			{
-				LogError("VertexBuffer::create() failed");
+				LogError("BatchRenderer::allocateRing() failed");
+				resetFrame();
 				return;
 			}
 		}
 
-		auto* indexBuffer = mRenderContext.indexBuffer;
-		if (indexBuffer->getNumIndices() < mStagingContext.numIndices)
+		if (numElements > 0)
 		{
-			indexBuffer->destroy();
-			if (!indexBuffer->create(wgpu::IndexFormat::Uint32, mStagingContext.numIndices))
+			const auto elementSize = mRenderContext.vertexLayout->getSize();
+			mRenderContext.vertexBuffer->write(elementSize * baseElement, elementSize * numElements, data);
+
+			mStats.uploadedBytes += elementSize * numElements;
+			mStats.numUploads++;
+
+			if (mTextureMode == BatchTextureMode::Array)
 			{
-				LogError("IndexBuffer::create() failed");
-				return;
+				mRenderContext.slotBuffer->write(sizeof(uint32_t) * baseElement, sizeof(uint32_t) * numElements,
+					mStagingContext.slots.data());
+
+				mStats.uploadedBytes += sizeof(uint32_t) * numElements;
+				mStats.numUploads++;
 			}
 		}
 
-		vertexBuffer->write(0, sizeof(Vertex) * mStagingContext.numVertices,
-			mStagingContext.vertices.data());
+		auto setRenderState = [&]() {
+			renderPass.setVertexBuffer(0, *mRenderContext.vertexBuffer);
+			if (mTextureMode == BatchTextureMode::Array)
+			{
+				renderPass.setVertexBuffer(1, *mRenderContext.slotBuffer);
+			}
+
+			if (!isInstanced)
+			{
+				renderPass.setIndexBuffer(*mRenderContext.indexBuffer);
+			}
 
-		indexBuffer->write(0, sizeof(uint32_t) * mStagingContext.numIndices,
-			mStagingContext.indices.data());
+			renderPass.setBindGroup(kCommonBindGroupIndex, *mRenderContext.bindGroup);
+			setCustomBindGroups(renderPass);
+		};
 
-		renderPass.setVertexBuffer(0, *mRenderContext.vertexBuffer);
-		renderPass.setIndexBuffer(*mRenderContext.indexBuffer);
-		renderPass.setBindGroup(kCommonBindGroupIndex, *mRenderContext.bindGroup);
+		setRenderState();
 
-		setCustomBindGroups(renderPass);
+		const RenderPipeline* currentPipeline{ nullptr };
+		const BindGroup* currentBindGroup{ nullptr };
 
 		for (auto& command : mCommands)
 		{
-			if (command.textureId != 0)
+			if (command.customDraw != kInvalidCustomDraw)
+			{
+				mCustomDraws[command.customDraw](renderPass, mViewProj);
+				setRenderState();
+
+				currentPipeline = nullptr;
+				currentBindGroup = nullptr;
+				continue;
+			}
+
+			auto* pipeline = command.textureId != 0 ? mRenderContext.texturedPipeline : mRenderContext.coloredPipeline;
+			if (pipeline != currentPipeline)
 			{
-				renderPass.setPipeline(*mRenderContext.texturedPipeline);
+				renderPass.setPipeline(*pipeline);
+				currentPipeline = pipeline;
+				mStats.numPipelineChanges++;
+			}
 
-				auto& bindGroups = mImageContext.bindGroups;
-				if (auto it = bindGroups.find(command.textureId); it != bindGroups.end())
+			if (command.textureId != 0)
+			{
+				if (auto* bindGroup = getImageBindGroup(command.textureId); bindGroup != nullptr && bindGroup != currentBindGroup)
 				{
-					renderPass.setBindGroup(kTextureBindGroupIndex, *it->second);
+					renderPass.setBindGroup(kTextureBindGroupIndex, *bindGroup);
+					currentBindGroup = bindGroup;
+					mStats.numBindGroupChanges++;
 				}
 			}
-			else
+
+			if (isInstanced)
 			{
-				renderPass.setPipeline(*mRenderContext.coloredPipeline);
+				renderPass.draw(6, command.numQuads, 0, baseElement + command.baseVertex / 4);
+				mStats.numDrawCalls++;
+				continue;
 			}
 
-			renderPass.drawIndexed(command.numIndices, 1, command.baseIndex);
+			for (uint32_t quad = 0; quad < command.numQuads; quad += kMaxQuadsPerDraw)
+			{
+				const auto numQuads = std::min(command.numQuads - quad, kMaxQuadsPerDraw);
+				renderPass.drawIndexed(numQuads * 6, 1, 0, (int32_t)(baseElement + command.baseVertex + quad * 4));
+				mStats.numDrawCalls++;
+			}
 		}
 
+		resetFrame();
+	}
+
+	void BatchRenderer::resetFrame()
+	{
 		mStagingContext.numVertices = 0;
-		mStagingContext.numIndices = 0;
 		mCurrentTexture = nullptr;
 		mCommands.clear();
+		mCustomDraws.clear();
 	}
 
 	void BatchRenderer::invalidateTexture(const Texture& texture)
@@ -164,6 +264,87 @@ namespace Trinity
 			bindGroups.erase(it);
 			mResourceCache->removeResource(bindGroup);
 		}
+
+		auto& textureSets = mImageContext.textureSets;
+		for (auto it = textureSets.begin(); it != textureSets.end();)
+		{
+			auto& textures = it->second.textures;
+			if (std::find(textures.begin(), textures.end(), &texture) != textures.end())
+			{
+				mResourceCache->removeResource(it->second.bindGroup);
+				it = textureSets.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	void BatchRenderer::resetStats()
+	{
+		mStats = {};
+	}
+
+	bool BatchRenderer::setVertexFormat(BatchVertexFormat vertexFormat)
+	{
+		if (mResourceCache != nullptr && vertexFormat != mVertexFormat)
+		{
+			LogError("BatchRenderer::setVertexFormat() failed, the vertex format must be set before create()");
+			return false;
+		}
+
+		mVertexFormat = vertexFormat;
+		return true;
+	}
+
+	bool BatchRenderer::setTextureMode(BatchTextureMode textureMode)
+	{
+		if (mResourceCache != nullptr && textureMode != mTextureMode)
+		{
+			LogError("BatchRenderer::setTextureMode() failed, the texture mode must be set before create()");
+			return false;
+		}
+
+		mTextureMode = textureMode;
+		return true;
+	}
+
+	void BatchRenderer::beginShards(uint32_t numShards)
+	{
+		if (numShards > (uint32_t)mShards.size())
+		{
+			mShards.resize(numShards);
+		}
+
+		for (uint32_t idx = 0; idx < numShards; idx++)
+		{
+			auto& shard = mShards[idx];
+			shard.numVertices = 0;
+			shard.layer = mLayer;
+			shard.currentTexture = nullptr;
+			shard.commands.clear();
+		}
+
+		mNumShards = numShards;
+	}
+
+	void BatchRenderer::setShardLayer(uint32_t shardIndex, uint32_t layer)
+	{
+		if (shardIndex < mNumShards)
+		{
+			mShards[shardIndex].layer = layer;
+		}
+	}
+
+	void BatchRenderer::setSortMode(BatchSortMode sortMode)
+	{
+		mSortMode = sortMode;
+	}
+
+	void BatchRenderer::setLayer(uint32_t layer)
+	{
+		mLayer = layer;
 	}
 
 	bool BatchRenderer::drawRect(
@@ -173,7 +354,7 @@ namespace Trinity
 		const glm::mat4& transform, 
 		const glm::vec4& color)
 	{
-		if (!addCommand(nullptr, mStagingContext.numIndices, 6))
+		if (!addCommand(nullptr, mStagingContext.numVertices, 1))
 		{
 			LogError("BatchRenderer::addCommand() failed");
 			return false;
@@ -202,18 +383,7 @@ namespace Trinity
 			{ .position = glm::vec3(p4), .uv = { 0.0f, 0.0f }, .color = color }
 		};
 
-		auto numVertices = mStagingContext.numVertices;
-		uint32_t indices[6] = {
-			numVertices,
-			numVertices + 1,
-			numVertices + 2,
-			numVertices + 2,
-			numVertices + 3,
-			numVertices
-		};
-
 		addVertices(vertices, 4);
-		addIndices(indices, 6);
 
 		return true;
 	}
@@ -222,7 +392,7 @@ namespace Trinity
 		const glm::vec2& size,
 		const glm::vec4& color)
 	{
-		if (!addCommand(nullptr, mStagingContext.numIndices, 6))
+		if (!addCommand(nullptr, mStagingContext.numVertices, 1))
 		{
 			LogError("BatchRenderer::addCommand() failed");
 			return false;
@@ -240,18 +410,7 @@ namespace Trinity
 			{ .position = { x2, y1 }, .uv = { 0.0f, 0.0f }, .color = color }
 		};
 
-		auto numVertices = mStagingContext.numVertices;
-		uint32_t indices[6] = {
-			numVertices,
-			numVertices + 1,
-			numVertices + 2,
-			numVertices + 2,
-			numVertices + 3,
-			numVertices
-		};
-
 		addVertices(vertices, 4);
-		addIndices(indices, 6);
 
 		return true;
 	}
@@ -268,7 +427,7 @@ namespace Trinity
 		bool flipX, 
 		bool flipY)
 	{
-		if (!addCommand(texture, mStagingContext.numIndices, 6))
+		if (!addCommand(texture, mStagingContext.numVertices, 1))
 		{
 			LogError("BatchRenderer::addCommand() failed");
 			return false;
@@ -316,18 +475,7 @@ namespace Trinity
 			{ .position = glm::vec2(p4), .uv = { u2, v2 }, .color = color }
 		};
 
-		auto numVertices = mStagingContext.numVertices;
-		uint32_t indices[6] = {
-			numVertices,
-			numVertices + 1,
-			numVertices + 2,
-			numVertices + 2,
-			numVertices + 3,
-			numVertices
-		};
-
 		addVertices(vertices, 4);
-		addIndices(indices, 6);
 
 		return true;
 	}
@@ -342,66 +490,15 @@ namespace Trinity
 		bool flipX, 
 		bool flipY)
 	{
-		if (!addCommand(texture, mStagingContext.numIndices, 6))
+		if (!addCommand(texture, mStagingContext.numVertices, 1))
 		{
 			LogError("BatchRenderer::addCommand() failed");
 			return false;
 		}
 
-		glm::vec3 localOrigin = {
-			srcSize.x * origin.x,
-			srcSize.y * origin.y,
-			0.0f
-		};
-
-		float x1{ -localOrigin.x };
-		float y1{ -localOrigin.y };
-		float x2{ x1 + srcSize.x };
-		float y2{ y1 + srcSize.y };
-
-		glm::vec4 p1 = transform * glm::vec4{ x1, y1, 0.0f, 1.0f };
-		glm::vec4 p2 = transform * glm::vec4{ x1, y2, 0.0f, 1.0f };
-		glm::vec4 p3 = transform * glm::vec4{ x2, y2, 0.0f, 1.0f };
-		glm::vec4 p4 = transform * glm::vec4{ x2, y1, 0.0f, 1.0f };
-
-		float u1{ srcPosition.x * mInvTextureSize.x };
-		float v1{ srcPosition.y * mInvTextureSize.y };
-		float u2{ (srcPosition.x + srcSize.x) * mInvTextureSize.x };
-		float v2{ (srcPosition.y + srcSize.y) * mInvTextureSize.y };
-
-		if (flipX)
-		{
-			auto t = u1;
-			u1 = u2;
-			u2 = t;
-		}
-
-		if (flipY)
-		{
-			auto t = v1;
-			v1 = v2;
-			v2 = t;
-		}
-
-		Vertex vertices[4] = {
-			{ .position = glm::vec2(p1), .uv = { u1, v2 }, .color = color },
-			{ .position = glm::vec2(p2), .uv = { u1, v1 }, .color = color },
-			{ .position = glm::vec2(p3), .uv = { u2, v1 }, .color = color },
-			{ .position = glm::vec2(p4), .uv = { u2, v2 }, .color = color }
-		};
-
-		auto numVertices = mStagingContext.numVertices;
-		uint32_t indices[6] = {
-			numVertices,
-			numVertices + 1,
-			numVertices + 2,
-			numVertices + 2,
-			numVertices + 3,
-			numVertices
-		};
-
+		Vertex vertices[4];
+		buildTextureQuad(vertices, mInvTextureSize, srcPosition, srcSize, origin, transform, color, flipX, flipY);
 		addVertices(vertices, 4);
-		addIndices(indices, 6);
 
 		return true;
 	}
@@ -416,7 +513,7 @@ namespace Trinity
 		bool flipX,
 		bool flipY)
 	{
-		if (!addCommand(texture, mStagingContext.numIndices, 6))
+		if (!addCommand(texture, mStagingContext.numVertices, 1))
 		{
 			LogError("BatchRenderer::addCommand() failed");
 			return false;
@@ -453,22 +550,147 @@ namespace Trinity
 			{ .position = { x2, y1 }, .uv = { u2, v2 }, .color = color }
 		};
 
-		auto numVertices = mStagingContext.numVertices;
-		uint32_t indices[6] = {
-			numVertices,
-			numVertices + 1,
-			numVertices + 2,
-			numVertices + 2,
-			numVertices + 3,
-			numVertices
-		};
-
 		addVertices(vertices, 4);
-		addIndices(indices, 6);
 
 		return true;
 	}
 
+	bool BatchRenderer::drawShardQuad(uint32_t shardIndex, Texture* texture, const Vertex* vertices)
+	{
+		auto* shardVertices = allocateShardQuads(shardIndex, texture, 1);
+		if (shardVertices == nullptr)
+		{
+			LogError("BatchRenderer::allocateShardQuads() failed");
+			return false;
+		}
+
+		std::memcpy(shardVertices, vertices, sizeof(Vertex) * 4);
+		return true;
+	}
+
+	void BatchRenderer::drawCustom(std::function<void(const RenderPass&, const glm::mat4&)> draw)
+	{
+		mCommands.push_back({
+			.layer = mLayer,
+			.customDraw = (uint32_t)mCustomDraws.size()
+		});
+
+		mCustomDraws.push_back(std::move(draw));
+	}
+
+	BatchRenderer::Vertex* BatchRenderer::allocateQuads(Texture* texture, uint32_t numQuads)
+	{
+		if (numQuads == 0)
+		{
+			return nullptr;
+		}
+
+		const auto baseVertex = mStagingContext.numVertices;
+		if (!addCommand(texture, baseVertex, numQuads))
+		{
+			LogError("BatchRenderer::addCommand() failed");
+			return nullptr;
+		}
+
+		auto& allVertices = mStagingContext.vertices;
+		if (baseVertex + numQuads * 4 > (uint32_t)allVertices.size())
+		{
+			allVertices.resize(baseVertex + numQuads * 4 + 5000);
+		}
+
+		mStagingContext.numVertices += numQuads * 4;
+		return &allVertices[baseVertex];
+	}
+
+	BatchRenderer::Vertex* BatchRenderer::allocateShardQuads(uint32_t shardIndex, Texture* texture, uint32_t numQuads)
+	{
+		if (numQuads == 0 || shardIndex >= mNumShards)
+		{
+			return nullptr;
+		}
+
+		auto& shard = mShards[shardIndex];
+		auto& commands = shard.commands;
+		const auto baseVertex = shard.numVertices;
+
+		if (commands.empty() || shard.currentTexture != texture || commands.back().layer != shard.layer)
+		{
+			commands.push_back({
+				.texture = texture,
+				.numQuads = numQuads,
+				.baseVertex = baseVertex,
+				.layer = shard.layer
+			});
+
+			shard.currentTexture = texture;
+		}
+		else
+		{
+			commands.back().numQuads += numQuads;
+		}
+
+		auto& vertices = shard.vertices;
+		if (baseVertex + numQuads * 4 > (uint32_t)vertices.size())
+		{
+			vertices.resize(baseVertex + numQuads * 4 + 5000);
+		}
+
+		shard.numVertices += numQuads * 4;
+		return &vertices[baseVertex];
+	}
+
+	void BatchRenderer::buildTextureQuad(
+		Vertex* vertices,
+		const glm::vec2& invTextureSize,
+		const glm::vec2& srcPosition,
+		const glm::vec2& srcSize,
+		const glm::vec2& origin,
+		const glm::mat4& transform,
+		const glm::vec4& color,
+		bool flipX,
+		bool flipY)
+	{
+		glm::vec3 localOrigin = {
+			srcSize.x * origin.x,
+			srcSize.y * origin.y,
+			0.0f
+		};
+
+		float x1{ -localOrigin.x };
+		float y1{ -localOrigin.y };
+		float x2{ x1 + srcSize.x };
+		float y2{ y1 + srcSize.y };
+
+		glm::vec4 p1 = transform * glm::vec4{ x1, y1, 0.0f, 1.0f };
+		glm::vec4 p2 = transform * glm::vec4{ x1, y2, 0.0f, 1.0f };
+		glm::vec4 p3 = transform * glm::vec4{ x2, y2, 0.0f, 1.0f };
+		glm::vec4 p4 = transform * glm::vec4{ x2, y1, 0.0f, 1.0f };
+
+		float u1{ srcPosition.x * invTextureSize.x };
+		float v1{ srcPosition.y * invTextureSize.y };
+		float u2{ (srcPosition.x + srcSize.x) * invTextureSize.x };
+		float v2{ (srcPosition.y + srcSize.y) * invTextureSize.y };
+
+		if (flipX)
+		{
+			auto t = u1;
+			u1 = u2;
+			u2 = t;
+		}
+
+		if (flipY)
+		{
+			auto t = v1;
+			v1 = v2;
+			v2 = t;
+		}
+
+		vertices[0] = { .position = glm::vec2(p1), .uv = { u1, v2 }, .color = color };
+		vertices[1] = { .position = glm::vec2(p2), .uv = { u1, v1 }, .color = color };
+		vertices[2] = { .position = glm::vec2(p3), .uv = { u2, v1 }, .color = color };
+		vertices[3] = { .position = glm::vec2(p4), .uv = { u2, v2 }, .color = color };
+	}
+
 	void BatchRenderer::addVertices(const Vertex* vertices, uint32_t numVertices)
 	{
 		auto& allVertices = mStagingContext.vertices;
@@ -481,25 +703,189 @@ namespace Trinity
 		mStagingContext.numVertices += numVertices;
 	}
 
-	void BatchRenderer::addIndices(const uint32_t* indices, uint32_t numIndices)
+	void BatchRenderer::buildTextureSets()
 	{
-		auto& allIndices = mStagingContext.indices;
-		if (mStagingContext.numIndices + numIndices > (uint32_t)allIndices.size())
+		const auto quadElements = mVertexFormat == BatchVertexFormat::Instanced ? 1u : 4u;
+
+		auto& slots = mStagingContext.slots;
+		slots.resize(mStagingContext.numVertices / 4 * quadElements);
+
+		auto& commands = mSortContext.commands;
+		auto& setTextures = mImageContext.setTextures;
+
+		commands.clear();
+		setTextures.clear();
+
+		for (auto& command : mCommands)
 		{
-			allIndices.resize(allIndices.size() + 10000);
+			if (command.textureId == 0)
+			{
+				if (!setTextures.empty())
+				{
+					commands.back().textureId = closeTextureSet();
+				}
+
+				commands.push_back(command);
+				continue;
+			}
+
+			auto isOpen = !setTextures.empty();
+			auto it = std::find(setTextures.begin(), setTextures.end(), command.texture);
+
+			if (it == setTextures.end())
+			{
+				if (setTextures.size() == kMaxTextureSlots)
+				{
+					commands.back().textureId = closeTextureSet();
+					isOpen = false;
+				}
+
+				setTextures.push_back(command.texture);
+				it = setTextures.end() - 1;
+			}
+
+			const auto slot = (uint32_t)(it - setTextures.begin());
+			std::fill_n(slots.begin() + command.baseVertex / 4 * quadElements, command.numQuads * quadElements, slot);
+
+			if (isOpen)
+			{
+				commands.back().numQuads += command.numQuads;
+			}
+			else
+			{
+				commands.push_back({
+					.texture = command.texture,
+					.numQuads = command.numQuads,
+					.baseVertex = command.baseVertex,
+					.layer = command.layer
+				});
+			}
+		}
+
+		if (!setTextures.empty())
+		{
+			commands.back().textureId = closeTextureSet();
+		}
+
+		mCommands.swap(commands);
+		evictTextureSets();
+	}
+
+	size_t BatchRenderer::closeTextureSet()
+	{
+		auto& setTextures = mImageContext.setTextures;
+		auto& textureSets = mImageContext.textureSets;
+
+		size_t key{ setTextures.size() };
+		for (auto* texture : setTextures)
+		{
+			key ^= std::hash<const Texture*>{}(texture) + 0x9e3779b9 + (key << 6) + (key >> 2);
+		}
+
+		auto it = textureSets.find(key);
+		while (key == 0 || (it != textureSets.end() && it->second.textures != setTextures))
+		{
+			it = textureSets.find(++key);
+		}
+
+		if (it == textureSets.end())
+		{
+			it = textureSets.emplace(key, TextureSet{
+				.bindGroup = createTextureSetBindGroup(setTextures),
+				.textures = setTextures
+			}).first;
+		}
+		else if (it->second.bindGroup == nullptr)
+		{
+			it->second.bindGroup = createTextureSetBindGroup(setTextures);
+		}
+
+		it->second.frameIndex = GraphicsDevice::get().getFrameIndex();
+		setTextures.clear();
+
+		return key;
+	}
+
+	BindGroup* BatchRenderer::getImageBindGroup(size_t textureId) const
+	{
+		if (mTextureMode == BatchTextureMode::Array)
+		{
+			auto& textureSets = mImageContext.textureSets;
+			if (auto it = textureSets.find(textureId); it != textureSets.end())
+			{
+				return it->second.bindGroup;
+			}
 		}
+		else
+		{
+			auto& bindGroups = mImageContext.bindGroups;
+			if (auto it = bindGroups.find(textureId); it != bindGroups.end())
+			{
+				return it->second;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void BatchRenderer::packVertices(uint32_t numVertices)
+	{
+		auto& packedVertices = mStagingContext.packedVertices;
+		if (numVertices > (uint32_t)packedVertices.size())
+		{
+			packedVertices.resize(numVertices);
+		}
+
+		const auto* vertices = mStagingContext.vertices.data();
+		for (uint32_t idx = 0; idx < numVertices; idx++)
+		{
+			auto& vertex = vertices[idx];
+			packedVertices[idx] = {
+				.position = vertex.position,
+				.uv = glm::packUnorm2x16(vertex.uv),
+				.color = glm::packUnorm4x8(vertex.color)
+			};
+		}
+	}
 
-		std::memcpy(&allIndices[mStagingContext.numIndices], indices, sizeof(uint32_t) * numIndices);
-		mStagingContext.numIndices += numIndices;
+	void BatchRenderer::packInstances(uint32_t numVertices)
+	{
+		const auto numQuads = numVertices / 4;
+
+		auto& instances = mStagingContext.instances;
+		if (numQuads > (uint32_t)instances.size())
+		{
+			instances.resize(numQuads);
+		}
+
+		const auto* vertices = mStagingContext.vertices.data();
+		for (uint32_t idx = 0; idx < numQuads; idx++)
+		{
+			instances[idx] = {
+				.position = vertices[0].position,
+				.axisX = glm::packHalf2x16(vertices[3].position - vertices[0].position),
+				.axisY = glm::packHalf2x16(vertices[1].position - vertices[0].position),
+				.uvStart = glm::packUnorm2x16(vertices[0].uv),
+				.uvEnd = glm::packUnorm2x16(vertices[2].uv),
+				.color = glm::packHalf4x16(vertices[0].color)
+			};
+
+			vertices += 4;
+		}
 	}
 
-	bool BatchRenderer::addCommand(Texture* texture, uint32_t baseIndex, uint32_t numIndices)
+	bool BatchRenderer::addCommand(Texture* texture, uint32_t baseVertex, uint32_t numQuads)
 	{
+		const auto layerChanged = !mCommands.empty() && mCommands.back().layer != mLayer;
+		const auto afterCustomDraw = !mCommands.empty() && mCommands.back().customDraw != kInvalidCustomDraw;
+
 		if (texture != nullptr)
 		{
-			if (mCurrentTexture != texture)
+			if (mCurrentTexture != texture || layerChanged || afterCustomDraw)
 			{
-				if (!createImageBindGroup(*texture))
+				const auto textureId = std::hash<const Texture*>{}(texture);
+				if (mTextureMode == BatchTextureMode::Single && !mImageContext.bindGroups.contains(textureId) &&
+					!createImageBindGroup(*texture))
 				{
 					LogError("TextRenderer::createImageBindGroup() failed");
 					return false;
@@ -511,9 +897,11 @@ namespace Trinity
 				};
 
 				DrawCommand drawCommand = {
-					.textureId = std::hash<const Texture*>{}(texture),
-					.numIndices = numIndices,
-					.baseIndex = baseIndex
+					.texture = texture,
+					.textureId = textureId,
+					.numQuads = numQuads,
+					.baseVertex = baseVertex,
+					.layer = mLayer
 				};
 
 				mCommands.push_back(drawCommand);
@@ -522,17 +910,18 @@ namespace Trinity
 			else
 			{
 				auto& command = mCommands.back();
-				command.numIndices += numIndices;
+				command.numQuads += numQuads;
 			}
 		}
 		else
 		{
-			if (mCommands.empty() || mCurrentTexture != nullptr)
+			if (mCommands.empty() || mCurrentTexture != nullptr || layerChanged || afterCustomDraw)
 			{
 				DrawCommand drawCommand = {
 					.textureId = 0,
-					.numIndices = numIndices,
-					.baseIndex = baseIndex
+					.numQuads = numQuads,
+					.baseVertex = baseVertex,
+					.layer = mLayer
 				};
 
 				mCommands.push_back(drawCommand);
@@ -542,13 +931,166 @@ namespace Trinity
 			else
 			{
 				auto& command = mCommands.back();
-				command.numIndices += numIndices;
+				command.numQuads += numQuads;
 			}
 		}
 
 		return true;
 	}
 
+	bool BatchRenderer::mergeShards()
+	{
+		auto numVertices = mStagingContext.numVertices;
+		for (uint32_t idx = 0; idx < mNumShards; idx++)
+		{
+			numVertices += mShards[idx].numVertices;
+		}
+
+		auto& allVertices = mStagingContext.vertices;
+		if (numVertices > (uint32_t)allVertices.size())
+		{
+			allVertices.resize(numVertices + 5000);
+		}
+
+		const auto layer = mLayer;
+		auto result{ true };
+
+		for (uint32_t idx = 0; idx < mNumShards; idx++)
+		{
+			auto& shard = mShards[idx];
+			for (auto& command : shard.commands)
+			{
+				mLayer = command.layer;
+				if (result && !addCommand(command.texture, mStagingContext.numVertices + command.baseVertex, command.numQuads))
+				{
+					LogError("BatchRenderer::addCommand() failed");
+					result = false;
+				}
+			}
+
+			if (result && shard.numVertices > 0)
+			{
+				std::memcpy(&allVertices[mStagingContext.numVertices], shard.vertices.data(), sizeof(Vertex) * shard.numVertices);
+				mStagingContext.numVertices += shard.numVertices;
+			}
+
+			shard.numVertices = 0;
+			shard.currentTexture = nullptr;
+			shard.commands.clear();
+		}
+
+		mLayer = layer;
+		mNumShards = 0;
+
+		return result;
+	}
+
+	void BatchRenderer::sortCommands()
+	{
+		auto& keys = mSortContext.keys;
+		auto& order = mSortContext.order;
+		auto& scratch = mSortContext.scratch;
+		auto& textureIndices = mSortContext.textureIndices;
+
+		const auto numCommands = (uint32_t)mCommands.size();
+		keys.resize(numCommands);
+		order.resize(numCommands);
+		scratch.resize(numCommands);
+		textureIndices.clear();
+
+		uint64_t keysOr{ 0 };
+		uint64_t keysAnd{ ~0ull };
+
+		for (uint32_t idx = 0; idx < numCommands; idx++)
+		{
+			auto& command = mCommands[idx];
+
+			uint64_t key = (uint64_t)command.layer << 32;
+			if (command.customDraw != kInvalidCustomDraw)
+			{
+				key |= 0xffffffffull;
+			}
+			else if (command.textureId != 0)
+			{
+				auto textureIndex = textureIndices.emplace(command.textureId, (uint32_t)textureIndices.size()).first->second;
+				key |= (1ull << 31) | textureIndex;
+			}
+
+			keys[idx] = key;
+			order[idx] = idx;
+			keysOr |= key;
+			keysAnd &= key;
+		}
+
+		for (uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			if ((((keysOr ^ keysAnd) >> shift) & 0xff) == 0)
+			{
+				continue;
+			}
+
+			std::array<uint32_t, 257> offsets{};
+			for (auto idx : order)
+			{
+				offsets[((keys[idx] >> shift) & 0xff) + 1]++;
+			}
+
+			for (uint32_t digit = 1; digit < (uint32_t)offsets.size(); digit++)
+			{
+				offsets[digit] += offsets[digit - 1];
+			}
+
+			for (auto idx : order)
+			{
+				scratch[offsets[(keys[idx] >> shift) & 0xff]++] = idx;
+			}
+
+			order.swap(scratch);
+		}
+
+		auto& vertices = mSortContext.vertices;
+		auto& commands = mSortContext.commands;
+
+		vertices.resize(std::max((uint32_t)mStagingContext.vertices.size(), mStagingContext.numVertices));
+		commands.clear();
+
+		uint32_t baseVertex{ 0 };
+		for (auto idx : order)
+		{
+			auto& command = mCommands[idx];
+			if (command.customDraw != kInvalidCustomDraw)
+			{
+				commands.push_back(command);
+				continue;
+			}
+
+			const auto numVertices = command.numQuads * 4;
+
+			std::memcpy(&vertices[baseVertex], &mStagingContext.vertices[command.baseVertex], sizeof(Vertex) * numVertices);
+
+			if (!commands.empty() && commands.back().textureId == command.textureId &&
+				commands.back().customDraw == kInvalidCustomDraw)
+			{
+				commands.back().numQuads += command.numQuads;
+			}
+			else
+			{
+				commands.push_back({
+					.texture = command.texture,
+					.textureId = command.textureId,
+					.numQuads = command.numQuads,
+					.baseVertex = baseVertex,
+					.layer = command.layer
+				});
+			}
+
+			baseVertex += numVertices;
+		}
+
+		mStagingContext.vertices.swap(vertices);
+		mCommands.swap(commands);
+	}
+
 	bool BatchRenderer::createCommonBindGroup(uint32_t perFrameDataSize)
 	{
 		auto perFrameBuffer = std::make_unique<UniformBuffer>();
@@ -558,7 +1100,7 @@ namespace Trinity
 			return false;
 		}
 
-		const std::vector<BindGroupLayoutItem> imageLayoutItems =
+		std::vector<BindGroupLayoutItem> imageLayoutItems =
 		{
 			{
 				.binding = 0,
@@ -577,6 +1119,21 @@ namespace Trinity
 			}
 		};
 
+		if (mTextureMode == BatchTextureMode::Array)
+		{
+			for (uint32_t slot = 1; slot < kMaxTextureSlots; slot++)
+			{
+				imageLayoutItems.push_back({
+					.binding = slot + 1,
+					.shaderStages = wgpu::ShaderStage::Fragment,
+					.bindingLayout = TextureBindingLayout {
+						.sampleType = wgpu::TextureSampleType::Float,
+						.viewDimension = wgpu::TextureViewDimension::e2D
+					}
+				});
+			}
+		}
+
 		auto imageBindGroupLayout = std::make_unique<BindGroupLayout>();
 		if (!imageBindGroupLayout->create(imageLayoutItems))
 		{
@@ -632,7 +1189,7 @@ namespace Trinity
 		return true;
 	}
 
-	bool BatchRenderer::createImageBindGroup(const Texture& texture)
+	bool BatchRenderer::createSampler()
 	{
 		if (mImageContext.sampler == nullptr)
 		{
@@ -654,6 +1211,17 @@ namespace Trinity
 			mResourceCache->addResource(std::move(sampler));
 		}
 
+		return true;
+	}
+
+	bool BatchRenderer::createImageBindGroup(const Texture& texture)
+	{
+		if (!createSampler())
+		{
+			LogError("BatchRenderer::createSampler() failed!!");
+			return false;
+		}
+
 		const std::vector<BindGroupItem> bindGroupItems =
 		{
 			{
@@ -682,17 +1250,117 @@ namespace Trinity
 		return true;
 	}
 
+	BindGroup* BatchRenderer::createTextureSetBindGroup(const std::vector<Texture*>& textures)
+	{
+		if (!createSampler())
+		{
+			LogError("BatchRenderer::createSampler() failed!!");
+			return nullptr;
+		}
+
+		std::vector<BindGroupItem> bindGroupItems =
+		{
+			{
+				.binding = 0,
+				.resource = SamplerBindingResource(*mImageContext.sampler)
+			}
+		};
+
+		for (uint32_t slot = 0; slot < kMaxTextureSlots; slot++)
+		{
+			auto* texture = slot < (uint32_t)textures.size() ? textures[slot] : textures[0];
+			bindGroupItems.push_back({
+				.binding = slot + 1,
+				.resource = TextureBindingResource(*texture)
+			});
+		}
+
+		auto bindGroup = std::make_unique<BindGroup>();
+		if (!bindGroup->create(*mImageContext.bindGroupLayout, bindGroupItems))
+		{
+			LogError("BindGroup::create() failed!!");
+			return nullptr;
+		}
+
+		auto* result = bindGroup.get();
+		mResourceCache->addResource(std::move(bindGroup));
+
+		return result;
+	}
+
+	void BatchRenderer::evictTextureSets()
+	{
+		auto& textureSets = mImageContext.textureSets;
+		const auto frameIndex = GraphicsDevice::get().getFrameIndex();
+
+		while (textureSets.size() > kMaxTextureSets)
+		{
+			auto oldest = textureSets.end();
+			for (auto it = textureSets.begin(); it != textureSets.end(); ++it)
+			{
+				if (it->second.frameIndex < frameIndex &&
+					(oldest == textureSets.end() || it->second.frameIndex < oldest->second.frameIndex))
+				{
+					oldest = it;
+				}
+			}
+
+			if (oldest == textureSets.end())
+			{
+				break;
+			}
+
+			mResourceCache->removeResource(oldest->second.bindGroup);
+			textureSets.erase(oldest);
+			mStats.numTextureSetEvictions++;
+		}
+	}
+
 	bool BatchRenderer::createBufferData()
 	{
 		auto vertexLayout = std::make_unique<VertexLayout>();
-		vertexLayout->setAttributes({
-			{ wgpu::VertexFormat::Float32x2, 0, 0 },
-			{ wgpu::VertexFormat::Float32x2, 8, 1 },
-			{ wgpu::VertexFormat::Float32x4, 16, 2 }
-		});
+		if (mVertexFormat == BatchVertexFormat::Packed)
+		{
+			vertexLayout->setAttributes({
+				{ wgpu::VertexFormat::Float32x2, 0, 0 },
+				{ wgpu::VertexFormat::Unorm16x2, 8, 1 },
+				{ wgpu::VertexFormat::Unorm8x4, 12, 2 }
+			});
+		}
+		else if (mVertexFormat == BatchVertexFormat::Instanced)
+		{
+			vertexLayout->setAttributes({
+				{ wgpu::VertexFormat::Float32x2, 0, 0 },
+				{ wgpu::VertexFormat::Float16x2, 8, 1 },
+				{ wgpu::VertexFormat::Float16x2, 12, 2 },
+				{ wgpu::VertexFormat::Unorm16x2, 16, 3 },
+				{ wgpu::VertexFormat::Unorm16x2, 20, 4 },
+				{ wgpu::VertexFormat::Float16x4, 24, 5 }
+			}, wgpu::VertexStepMode::Instance);
+		}
+		else
+		{
+			vertexLayout->setAttributes({
+				{ wgpu::VertexFormat::Float32x2, 0, 0 },
+				{ wgpu::VertexFormat::Float32x2, 8, 1 },
+				{ wgpu::VertexFormat::Float32x4, 16, 2 }
+			});
+		}
 
 		uint32_t numVertices = 128 * 1024;
-		uint32_t numIndices = 256 * 1024;
+
+		std::vector<uint16_t> indices(kMaxQuadsPerDraw * 6);
+		for (uint32_t idx = 0; idx < kMaxQuadsPerDraw; idx++)
+		{
+			const auto vertex = (uint16_t)(idx * 4);
+
+			indices[idx * 6 + 0] = vertex;
+			indices[idx * 6 + 1] = vertex + 1;
+			indices[idx * 6 + 2] = vertex + 2;
+			indices[idx * 6 + 3] = vertex + 2;
+			indices[idx * 6 + 4] = vertex + 3;
+			indices[idx * 6 + 5] = vertex;
+		}
 
 		auto vertexBuffer = std::make_unique<VertexBuffer>();
 		if (!vertexBuffer->create(*vertexLayout, numVertices))
@@ -702,14 +1370,35 @@ namespace Trinity
 		}
 
 		auto indexBuffer = std::make_unique<IndexBuffer>();
-		if (!indexBuffer->create(wgpu::IndexFormat::Uint32, numIndices))
+		if (!indexBuffer->create(wgpu::IndexFormat::Uint16, (uint32_t)indices.size(), indices.data()))
 		{
 			LogError("IndexBuffer::create() failed!!");
 			return false;
 		}
 
+		if (mTextureMode == BatchTextureMode::Array)
+		{
+			auto slotLayout = std::make_unique<VertexLayout>();
+			slotLayout->setAttributes({
+				{ wgpu::VertexFormat::Uint32, 0, 7 }
+			}, mVertexFormat == BatchVertexFormat::Instanced ? wgpu::VertexStepMode::Instance : wgpu::VertexStepMode::Vertex);
+
+			auto slotBuffer = std::make_unique<VertexBuffer>();
+			if (!slotBuffer->create(*slotLayout, numVertices))
+			{
+				LogError("VertexBuffer::create() failed!!");
+				return false;
+			}
+
+			mRenderContext.slotLayout = slotLayout.get();
+			mRenderContext.slotBuffer = slotBuffer.get();
+
+			mResourceCache->addResource(std::move(slotLayout));
+			mResourceCache->addResource(std::move(slotBuffer));
+		}
+
 		mStagingContext.vertices.resize(numVertices);
-		mStagingContext.indices.resize(numIndices);
+		mVertexRing = { .capacity = numVertices };
 
 		mRenderContext.vertexLayout = vertexLayout.get();
 		mRenderContext.vertexBuffer = vertexBuffer.get();
@@ -722,6 +1411,78 @@ namespace Trinity
 		return true;
 	}
 
+	bool BatchRenderer::growVertexBuffer(uint32_t numVertices)
+	{
+		const auto capacity = std::max(mVertexRing.capacity * 2, numVertices * 2);
+
+		auto* vertexBuffer = mRenderContext.vertexBuffer;
+		vertexBuffer->destroy();
+
+		if (!vertexBuffer->create(*mRenderContext.vertexLayout, capacity))
+		{
+			LogError("VertexBuffer::create() failed!!");
+			return false;
+		}
+
+		if (auto* slotBuffer = mRenderContext.slotBuffer; slotBuffer != nullptr)
+		{
+			slotBuffer->destroy();
+
+			if (!slotBuffer->create(*mRenderContext.slotLayout, capacity))
+			{
+				LogError("VertexBuffer::create() failed!!");
+				return false;
+			}
+		}
+
+		mVertexRing = {
+			.capacity = capacity,
+			.frameIndex = mVertexRing.frameIndex
+		};
+
+		mStats.numReallocations++;
+		return true;
+	}
+
+	void BatchRenderer::advanceRing(RingContext& ring, uint64_t frameIndex)
+	{
+		if (ring.frameIndex == frameIndex)
+		{
+			return;
+		}
+
+		const auto numFrames = std::min(frameIndex - ring.frameIndex, (uint64_t)kNumFramesInFlight);
+		for (uint64_t idx = 1; idx <= numFrames; idx++)
+		{
+			auto& frameSize = ring.frameSizes[(ring.frameIndex + idx) % kNumFramesInFlight];
+			ring.used -= frameSize;
+			frameSize = 0;
+		}
+
+		ring.frameIndex = frameIndex;
+	}
+
+	bool BatchRenderer::allocateRing(RingContext& ring, uint32_t count, uint32_t& offset)
+	{
+		const auto waste = ring.head + count > ring.capacity ? ring.capacity - ring.head : 0;
+		if (ring.used + waste + count > ring.capacity)
+		{
+			return false;
+		}
+
+		if (waste > 0)
+		{
+			ring.head = 0;
+		}
+
+		offset = ring.head;
+		ring.head += count;
+		ring.used += waste + count;
+		ring.frameSizes[ring.frameIndex % kNumFramesInFlight] += waste + count;
+
+		return true;
+	}
+
 	void BatchRenderer::setCustomBindGroups(const RenderPass& renderPass)
 	{
 	}
@@ -739,6 +1500,15 @@ namespace Trinity
 		const std::vector<const BindGroupLayout*>& customLayouts)
 	{
 		ShaderPreProcessor processor;
+		if (mVertexFormat == BatchVertexFormat::Instanced)
+		{
+			processor.addDefine("INSTANCED");
+		}
+
+		if (mTextureMode == BatchTextureMode::Array)
+		{
+			processor.addDefine("TEXTURE_ARRAY");
+		}
 
 		auto shader = std::make_unique<Shader>();
 		if (!shader->create(texturedShaderFile, processor))
@@ -750,10 +1520,16 @@ namespace Trinity
 		std::vector<const BindGroupLayout*> bindGroupLayouts = { mRenderContext.bindGroupLayout, mImageContext.bindGroupLayout };
 		bindGroupLayouts.insert(bindGroupLayouts.end(), customLayouts.begin(), customLayouts.end());
 
+		std::vector<const VertexLayout*> vertexLayouts = { mRenderContext.vertexLayout };
+		if (mRenderContext.slotLayout != nullptr)
+		{
+			vertexLayouts.push_back(mRenderContext.slotLayout);
+		}
+
 		RenderPipelineProperties renderProps = {
 			.shader = shader.get(),
 			.bindGroupLayouts = std::move(bindGroupLayouts),
-			.vertexLayouts = { mRenderContext.vertexLayout },
+			.vertexLayouts = std::move(vertexLayouts),
 			.colorTargets = {{
 				.format = renderTarget.getColorFormat(),
 				.blendState = wgpu::BlendState {
@@ -802,6 +1578,10 @@ namespace Trinity
 		const std::vector<const BindGroupLayout*>& customLayouts)
 	{
 		ShaderPreProcessor processor;
+		if (mVertexFormat == BatchVertexFormat::Instanced)
+		{
+			processor.addDefine("INSTANCED");
+		}
 
 		auto shader = std::make_unique<Shader>();
 		if (!shader->create(coloredShaderFile, processor))
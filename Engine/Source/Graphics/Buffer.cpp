@@ -14,13 +14,26 @@ namespace Trinity
         return typeid(Buffer);
     }
 
-    void Buffer::mapAsync(uint32_t offset, uint32_t size)
+    void Buffer::mapAsync(uint32_t offset, uint32_t size, wgpu::MapMode mode)
     {
-        mHandle.MapAsync(wgpu::MapMode::Write, offset, size,
+        mMapMode = mode;
+        mHandle.MapAsync(mode, offset, size,
             [](WGPUBufferMapAsyncStatus status, void* userdata) {
+                if (status == WGPUBufferMapAsyncStatus_DestroyedBeforeCallback ||
+                    status == WGPUBufferMapAsyncStatus_UnmappedBeforeCallback)
+                {
+                    return;
+                }
+
                 Assert(status == WGPUBufferMapAsyncStatus_Success, "wgpu::Buffer::MapAsync() failed!!");
 
                 Buffer* buffer = reinterpret_cast<Buffer*>(userdata);
+                if ((buffer->mMapMode & wgpu::MapMode::Read) != wgpu::MapMode::None)
+                {
+                    buffer->onMapAsyncCompleted.notify(const_cast<void*>(buffer->mHandle.GetConstMappedRange()));
+                    return;
+                }
+
                 buffer->onMapAsyncCompleted.notify(buffer->mHandle.GetMappedRange());
         }, this);
     }
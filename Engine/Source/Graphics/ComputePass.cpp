@@ -47,4 +47,27 @@ namespace Trinity
 		wgpu::CommandBuffer commands = mCommandEncoder.Finish();
 		graphicsDevice.getQueue().Submit(1, &commands);
 	}
+
+	void ComputePass::dispatch(uint32_t workgroupCountX, uint32_t workgroupCountY, uint32_t workgroupCountZ) const
+	{
+		Assert(mComputePassEncoder != nullptr, "ComputePass::begin() not called!!");
+		mComputePassEncoder.DispatchWorkgroups(workgroupCountX, workgroupCountY, workgroupCountZ);
+	}
+
+	void ComputePass::setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup) const
+	{
+		Assert(mComputePassEncoder != nullptr, "ComputePass::begin() not called!!");
+		mComputePassEncoder.SetBindGroup(groupIndex, bindGroup.getHandle());
+	}
+
+	void ComputePass::setPipeline(const ComputePipeline& pipeline) const
+	{
+		Assert(mComputePassEncoder != nullptr, "ComputePass::begin() not called!!");
+		mComputePassEncoder.SetPipeline(pipeline.getHandle());
+	}
+	void ComputePass::copyBuffer(const Buffer& src, uint32_t srcOffset, const Buffer& dst, uint32_t dstOffset, uint32_t size) const
+	{
+		Assert(mCommandEncoder != nullptr, "ComputePass::begin() not called!!");
+		mCommandEncoder.CopyBufferToBuffer(src.getHandle(), srcOffset, dst.getHandle(), dstOffset, size);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "Graphics/ComputePipeline.h"
+#include "Graphics/GraphicsDevice.h"
+#include "Core/Debugger.h"
+#include "Core/Logger.h"
+
+namespace Trinity
+{
+    ComputePipeline::~ComputePipeline()
+    {
+        destroy();
+    }
+
+    bool ComputePipeline::create(const ComputePipelineProperties& computeProps)
+    {
+        const wgpu::Device& device = GraphicsDevice::get();
+        std::vector<wgpu::BindGroupLayout> bindGroupLayouts;
+
+        for (const BindGroupLayout* bindGroupLayout : computeProps.bindGroupLayouts)
+        {
+            if (bindGroupLayout)
+            {
+                bindGroupLayouts.push_back(bindGroupLayout->getHandle());
+            }
+        }
+
+        wgpu::PipelineLayoutDescriptor layoutDesc = {
+            .bindGroupLayoutCount = static_cast<uint32_t>(bindGroupLayouts.size()),
+            .bindGroupLayouts = bindGroupLayouts.data()
+        };
+
+        mLayout = device.CreatePipelineLayout(&layoutDesc);
+        if (!mLayout)
+        {
+            LogError("wgpu::Device::CreatePipelineLayout() failed!!");
+            return false;
+        }
+
+        wgpu::ComputePipelineDescriptor pipelineDesc = {
+            .layout = mLayout,
+            .compute = {
+                .module = computeProps.shader->getHandle(),
+                .entryPoint = computeProps.csEntry.c_str()
+            }
+        };
+
+        mHandle = device.CreateComputePipeline(&pipelineDesc);
+        if (!mHandle)
+        {
+            LogError("wgpu::Device::CreateComputePipeline() failed!!");
+            return false;
+        }
+
+        return true;
+    }
+
+    void ComputePipeline::destroy()
+    {
+        mLayout = nullptr;
+        mHandle = nullptr;
+    }
+
+    std::type_index ComputePipeline::getType() const
+    {
+        return typeid(ComputePipeline);
+    }
+}
\ No newline at end of file
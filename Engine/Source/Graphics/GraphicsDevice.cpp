@@ -31,31 +31,24 @@ namespace Trinity
             return;
         }
 
-        wgpuInstanceRequestAdapter(mInstance.Get(), nullptr,
-            [](WGPURequestAdapterStatus status, WGPUAdapter adapter, char const* message, void* userdata) {
-                if (status != WGPURequestAdapterStatus_Success)
-                {
-                    LogError("wgpu::Instance::RequestAdapter() failed!!");
-                    reinterpret_cast<GraphicsDevice*>(userdata)->onCreated.notify(false);
-                    return;
-                }
+        requestAdapter(nullptr);
+    }
 
-                wgpuAdapterRequestDevice(adapter, nullptr,
-                    [](WGPURequestDeviceStatus status, WGPUDevice device, char const* message, void* userdata) {
-                        if (status != WGPURequestDeviceStatus_Success)
-                        {
-                            LogError("wgpu::Adapter::RequestDevice() failed!!");
-                            reinterpret_cast<GraphicsDevice*>(userdata)->onCreated.notify(false);
-                            return;
-                        }
+    void GraphicsDevice::createHeadless(wgpu::BackendType backendType, bool forceFallbackAdapter)
+    {
+        mInstance = wgpu::CreateInstance();
+        if (!mInstance)
+        {
+            LogError("wgpu::CreateInstance() failed!!");
+            onCreated.notify(false);
+            return;
+        }
 
-                        GraphicsDevice* graphics = reinterpret_cast<GraphicsDevice*>(userdata);
-                        graphics->setupDevice(wgpu::Device::Acquire(device));
-                        graphics->onCreated.notify(true);
-                    },
-                    userdata);
-            },
-        this);
+        WGPURequestAdapterOptions options{};
+        options.backendType = static_cast<WGPUBackendType>(backendType);
+        options.forceFallbackAdapter = forceFallbackAdapter;
+
+        requestAdapter(&options);
     }
 
     void GraphicsDevice::destroy()
@@ -90,6 +83,45 @@ namespace Trinity
     void GraphicsDevice::present()
     {
         mSwapChain.present();
+        mFrameIndex++;
+
+        poll();
+    }
+
+    void GraphicsDevice::poll()
+    {
+#ifndef __EMSCRIPTEN__
+        mDevice.Tick();
+#endif
+    }
+
+    void GraphicsDevice::requestAdapter(const WGPURequestAdapterOptions* options)
+    {
+        wgpuInstanceRequestAdapter(mInstance.Get(), options,
+            [](WGPURequestAdapterStatus status, WGPUAdapter adapter, char const* message, void* userdata) {
+                if (status != WGPURequestAdapterStatus_Success)
+                {
+                    LogError("wgpu::Instance::RequestAdapter() failed!!");
+                    reinterpret_cast<GraphicsDevice*>(userdata)->onCreated.notify(false);
+                    return;
+                }
+
+                wgpuAdapterRequestDevice(adapter, nullptr,
+                    [](WGPURequestDeviceStatus status, WGPUDevice device, char const* message, void* userdata) {
+                        if (status != WGPURequestDeviceStatus_Success)
+                        {
+                            LogError("wgpu::Adapter::RequestDevice() failed!!");
+                            reinterpret_cast<GraphicsDevice*>(userdata)->onCreated.notify(false);
+                            return;
+                        }
+
+                        GraphicsDevice* graphics = reinterpret_cast<GraphicsDevice*>(userdata);
+                        graphics->setupDevice(wgpu::Device::Acquire(device));
+                        graphics->onCreated.notify(true);
+                    },
+                    userdata);
+            },
+        this);
     }
 
     void GraphicsDevice::setupDevice(wgpu::Device device)
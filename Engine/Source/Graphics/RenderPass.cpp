@@ -69,6 +69,12 @@ namespace Trinity
         mRenderPassEncoder.DrawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
     }
 
+    void RenderPass::drawIndirect(const Buffer& indirectBuffer, uint64_t indirectOffset) const
+    {
+        Assert(mRenderPassEncoder != nullptr, "RenderPass::begin() not called!!");
+        mRenderPassEncoder.DrawIndirect(indirectBuffer.getHandle(), indirectOffset);
+    }
+
     void RenderPass::setBindGroup(uint32_t groupIndex, const BindGroup& bindGroup) const
     {
         Assert(mRenderPassEncoder != nullptr, "RenderPass::begin() not called!!");
@@ -10,13 +10,13 @@ namespace Trinity
 		destroy();
 	}
 
-	bool StorageBuffer::create(uint32_t size, const void* data)
+	bool StorageBuffer::create(uint32_t size, const void* data, wgpu::BufferUsage usage)
 	{
 		const wgpu::Device& device = GraphicsDevice::get();
 		mSize = size;
 
 		wgpu::BufferDescriptor bufferDescriptor{};
-		bufferDescriptor.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst;
+		bufferDescriptor.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst | usage;
 		bufferDescriptor.size = mSize;
 		bufferDescriptor.mappedAtCreation = false;
 
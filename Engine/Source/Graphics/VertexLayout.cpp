@@ -47,10 +47,18 @@ namespace Trinity
                 mSize += 16;
                 break;
 
+            case wgpu::VertexFormat::Uint32:
+                mSize += 4;
+                break;
+
             case wgpu::VertexFormat::Uint32x4:
                 mSize += 16;
                 break;
 
+            case wgpu::VertexFormat::Unorm16x2:
+                mSize += 4;
+                break;
+
             case wgpu::VertexFormat::Unorm8x4:
                 mSize += 4;
 
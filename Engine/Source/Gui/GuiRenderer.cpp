@@ -80,22 +80,10 @@ namespace Trinity
 				{ .position = glm::vec3(p4), .uv = { u2, v2 }, .color = color }
 			};
 
-			auto numVertices = mStagingContext.numVertices;
-			auto baseIndex = mStagingContext.numIndices;
-
-			uint32_t indices[6] = {
-				numVertices,
-				numVertices + 1,
-				numVertices + 2,
-				numVertices + 2,
-				numVertices + 3,
-				numVertices
-			};
-
+			auto baseVertex = mStagingContext.numVertices;
 			addVertices(vertices, 4);
-			addIndices(indices, 6);
 
-			if (!addCommand(texture, baseIndex, 6))
+			if (!addCommand(texture, baseVertex, 1))
 			{
 				LogError("BatchRenderer::addCommand() failed");
 				return false;
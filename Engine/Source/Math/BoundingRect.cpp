@@ -101,6 +101,11 @@ namespace Trinity
 			if (other.max.x > max.x)	status |= BoundCollideStatus::Right;
 			if (other.min.y < min.y)	status |= BoundCollideStatus::Bottom;
 			if (other.max.y > max.y)	status |= BoundCollideStatus::Top;
+
+			if (status == BoundCollideStatus::Outside)
+			{
+				status = BoundCollideStatus::Inside;
+			}
 		}
 
 		return (BoundCollideStatus)status;
@@ -0,0 +1,720 @@
+#include "Particle/GpuParticlePool.h"
+#include "Graphics/Texture.h"
+#include "Graphics/Sampler.h"
+#include "Graphics/Shader.h"
+#include "Graphics/ComputePass.h"
+#include "Graphics/ComputePipeline.h"
+#include "Graphics/RenderPass.h"
+#include "Graphics/RenderPipeline.h"
+#include "Graphics/RenderTarget.h"
+#include "Graphics/UniformBuffer.h"
+#include "Graphics/StorageBuffer.h"
+#include "Graphics/ReadbackBuffer.h"
+#include "Graphics/BindGroup.h"
+#include "Graphics/BindGroupLayout.h"
+#include "Core/Logger.h"
+#include <algorithm>
+
+namespace Trinity
+{
+	GpuParticlePool::~GpuParticlePool()
+	{
+		destroy();
+	}
+
+	bool GpuParticlePool::create(RenderTarget& renderTarget, uint32_t poolSize)
+	{
+		mNumParticles = std::max(poolSize, kWorkgroupSize);
+		mNumActive = 0;
+		mSrc = 0;
+
+		if (!createComputeContext())
+		{
+			LogError("GpuParticlePool::createComputeContext() failed!!");
+			return false;
+		}
+
+		auto* readbackBuffer = mComputeContext.readbackBuffer.get();
+		readbackBuffer->onMapAsyncCompleted.subscribe([this, readbackBuffer](void* data) {
+			mNumActive = *reinterpret_cast<const uint32_t*>(data);
+			mReadbackPending = false;
+			readbackBuffer->unmap();
+		});
+
+		if (!createRenderContext(renderTarget))
+		{
+			LogError("GpuParticlePool::createRenderContext() failed!!");
+			return false;
+		}
+
+		if (!createSlotContext(kColoredSlot, nullptr))
+		{
+			LogError("GpuParticlePool::createSlotContext() failed!!");
+			return false;
+		}
+
+		return true;
+	}
+
+	void GpuParticlePool::destroy()
+	{
+		mComputeContext = {};
+		mRenderContext = {};
+		mSlots.clear();
+		mEmitted.clear();
+		mFrameSlots.clear();
+		mEmittedCapacity = 0;
+		mNumUploadedFrames = 0;
+		mNumActive = 0;
+		mReadbackPending = false;
+	}
+
+	void GpuParticlePool::emit(const Particle& particle)
+	{
+		const auto frame = getFrameIndex(particle.textureFrame);
+		if (frame >= kMaxFrames)
+		{
+			LogError("GpuParticlePool::emit() failed, frame %u exceeds the %u frame limit!!", frame, kMaxFrames);
+			return;
+		}
+
+		mEmitted.push_back({
+			.position = particle.position,
+			.velocity = particle.velocity,
+			.acceleration = particle.acceleration,
+			.drag = particle.drag,
+			.lifeRemaining = particle.lifeSpan,
+			.startColor = particle.startColor,
+			.finalColor = particle.finalColor,
+			.startSize = particle.startSize,
+			.finalSize = particle.finalSize,
+			.startRotation = particle.startRotation,
+			.finalRotation = particle.finalRotation,
+			.invLifeSpan = particle.lifeSpan > 0.0f ? 1.0f / particle.lifeSpan : 0.0f,
+			.frame = frame
+		});
+	}
+
+	void GpuParticlePool::update(float deltaTime)
+	{
+		auto& context = mComputeContext;
+		if (context.bindGroups[mSrc] == nullptr)
+		{
+			return;
+		}
+
+		if (!uploadFrames())
+		{
+			LogError("GpuParticlePool::uploadFrames() failed!!");
+			return;
+		}
+
+		for (auto& particle : mEmitted)
+		{
+			particle.slot = mFrameSlots[particle.frame];
+		}
+
+		const auto numEmitted = std::min((uint32_t)mEmitted.size(), mNumParticles);
+		if (numEmitted > mEmittedCapacity)
+		{
+			mEmittedCapacity = std::min(std::max(numEmitted, mEmittedCapacity * 2), mNumParticles);
+			context.emittedBuffer = std::make_unique<StorageBuffer>();
+
+			if (!context.emittedBuffer->create(sizeof(GpuParticle) * mEmittedCapacity))
+			{
+				LogError("StorageBuffer::create() failed!!");
+				return;
+			}
+
+			if (!createComputeContext())
+			{
+				LogError("GpuParticlePool::createComputeContext() failed!!");
+				return;
+			}
+		}
+
+		if (numEmitted > 0)
+		{
+			context.emittedBuffer->write(0, sizeof(GpuParticle) * numEmitted, mEmitted.data());
+		}
+
+		SimulationData simulationData = {
+			.deltaTime = deltaTime / 1000.0f,
+			.numEmitted = numEmitted,
+			.capacity = mNumParticles,
+			.src = mSrc
+		};
+
+		context.simulationBuffer->write(0, sizeof(SimulationData), &simulationData);
+
+		ComputePass computePass;
+		if (!computePass.begin())
+		{
+			LogError("ComputePass::begin() failed!!");
+			return;
+		}
+
+		computePass.setBindGroup(0, *context.bindGroups[mSrc]);
+
+		if (numEmitted > 0)
+		{
+			computePass.setPipeline(*context.emitPipeline);
+			computePass.dispatch((numEmitted + kWorkgroupSize - 1) / kWorkgroupSize);
+		}
+
+		computePass.setPipeline(*context.simulatePipeline);
+		computePass.dispatch((mNumParticles + kWorkgroupSize - 1) / kWorkgroupSize);
+
+		computePass.setPipeline(*context.finalizePipeline);
+		computePass.dispatch(1);
+
+		computePass.setPipeline(*context.compactPipeline);
+		computePass.dispatch((mNumParticles + kWorkgroupSize - 1) / kWorkgroupSize);
+
+		computePass.end();
+
+		const auto readback = !mReadbackPending;
+		if (readback)
+		{
+			computePass.copyBuffer(*context.counterBuffer, sizeof(uint32_t) * (1 - mSrc), *context.readbackBuffer, 0, sizeof(uint32_t));
+		}
+
+		computePass.submit();
+
+		if (readback)
+		{
+			mReadbackPending = true;
+			context.readbackBuffer->mapAsync(0, sizeof(uint32_t), wgpu::MapMode::Read);
+		}
+
+		mEmitted.clear();
+		mSrc = 1 - mSrc;
+	}
+
+	void GpuParticlePool::draw(BatchRenderer& renderer, const glm::mat4& rootTransform)
+	{
+		renderer.drawCustom([this, rootTransform](const RenderPass& renderPass, const glm::mat4& viewProj) {
+			draw(renderPass, viewProj, rootTransform);
+		});
+	}
+
+	void GpuParticlePool::draw(const RenderPass& renderPass, const glm::mat4& viewProj, const glm::mat4& rootTransform)
+	{
+		auto& context = mRenderContext;
+		if (context.bindGroups[mSrc] == nullptr)
+		{
+			return;
+		}
+
+		PerFrameData perFrameData = {
+			.viewProj = viewProj,
+			.rootTransform = rootTransform
+		};
+
+		context.perFrameBuffer->write(0, sizeof(PerFrameData), &perFrameData);
+		renderPass.setBindGroup(0, *context.bindGroups[mSrc]);
+
+		for (uint32_t idx = 0; idx < (uint32_t)mSlots.size(); idx++)
+		{
+			auto& slot = mSlots[idx];
+			renderPass.setPipeline(slot.texture != nullptr ? *context.texturedPipeline : *context.coloredPipeline);
+			renderPass.setBindGroup(1, *slot.bindGroup);
+			renderPass.drawIndirect(*mComputeContext.drawArgsBuffer, sizeof(DrawArgs) * idx);
+		}
+	}
+
+	bool GpuParticlePool::createComputeContext()
+	{
+		auto& context = mComputeContext;
+
+		if (context.shader == nullptr)
+		{
+			ShaderPreProcessor processor;
+
+			context.shader = std::make_unique<Shader>();
+			if (!context.shader->create(kComputeShader, processor))
+			{
+				LogError("Shader::create() failed for: %s!!", kComputeShader);
+				return false;
+			}
+
+			const std::vector<BindGroupLayoutItem> layoutItems =
+			{
+				{
+					.binding = 0,
+					.shaderStages = wgpu::ShaderStage::Compute,
+					.bindingLayout = BufferBindingLayout {
+						.type = wgpu::BufferBindingType::Uniform,
+						.minBindingSize = sizeof(SimulationData)
+					}
+				},
+				{
+					.binding = 1,
+					.shaderStages = wgpu::ShaderStage::Compute,
+					.bindingLayout = BufferBindingLayout {
+						.type = wgpu::BufferBindingType::Storage
+					}
+				},
+				{
+					.binding = 2,
+					.shaderStages = wgpu::ShaderStage::Compute,
+					.bindingLayout = BufferBindingLayout {
+						.type = wgpu::BufferBindingType::Storage
+					}
+				},
+				{
+					.binding = 3,
+					.shaderStages = wgpu::ShaderStage::Compute,
+					.bindingLayout = BufferBindingLayout {
+						.type = wgpu::BufferBindingType::ReadOnlyStorage
+					}
+				},
+				{
+					.binding = 4,
+					.shaderStages = wgpu::ShaderStage::Compute,
+					.bindingLayout = BufferBindingLayout {
+						.type = wgpu::BufferBindingType::Storage
+					}
+				},
+				{
+					.binding = 5,
+					.shaderStages = wgpu::ShaderStage::Compute,
+					.bindingLayout = BufferBindingLayout {
+						.type = wgpu::BufferBindingType::Storage
+					}
+				},
+				{
+					.binding = 6,
+					.shaderStages = wgpu::ShaderStage::Compute,
+					.bindingLayout = BufferBindingLayout {
+						.type = wgpu::BufferBindingType::Storage
+					}
+				}
+			};
+
+			context.bindGroupLayout = std::make_unique<BindGroupLayout>();
+			if (!context.bindGroupLayout->create(layoutItems))
+			{
+				LogError("BindGroupLayout::create() failed!!");
+				return false;
+			}
+
+			auto createPipeline = [&](std::unique_ptr<ComputePipeline>& pipeline, const char* entry) {
+				pipeline = std::make_unique<ComputePipeline>();
+				return pipeline->create({
+					.shader = context.shader.get(),
+					.csEntry = entry,
+					.bindGroupLayouts = { context.bindGroupLayout.get() }
+				});
+			};
+
+			if (!createPipeline(context.emitPipeline, "cs_emit") ||
+				!createPipeline(context.simulatePipeline, "cs_simulate") ||
+				!createPipeline(context.finalizePipeline, "cs_finalize") ||
+				!createPipeline(context.compactPipeline, "cs_compact"))
+			{
+				LogError("ComputePipeline::create() failed!!");
+				return false;
+			}
+
+			const std::vector<uint32_t> counters(2 + kMaxSlots, 0);
+			const std::vector<DrawArgs> drawArgs(kMaxSlots);
+
+			context.simulationBuffer = std::make_unique<UniformBuffer>();
+			context.counterBuffer = std::make_unique<StorageBuffer>();
+			context.drawArgsBuffer = std::make_unique<StorageBuffer>();
+			context.slotOffsetBuffer = std::make_unique<StorageBuffer>();
+			context.emittedBuffer = std::make_unique<StorageBuffer>();
+			context.readbackBuffer = std::make_unique<ReadbackBuffer>();
+
+			if (!context.simulationBuffer->create(sizeof(SimulationData)) ||
+				!context.counterBuffer->create(sizeof(uint32_t) * (uint32_t)counters.size(), counters.data(), wgpu::BufferUsage::CopySrc) ||
+				!context.drawArgsBuffer->create(sizeof(DrawArgs) * kMaxSlots, drawArgs.data(), wgpu::BufferUsage::Indirect | wgpu::BufferUsage::CopySrc) ||
+				!context.slotOffsetBuffer->create(sizeof(uint32_t) * kMaxSlots) ||
+				!context.readbackBuffer->create(sizeof(uint32_t)))
+			{
+				LogError("Buffer::create() failed!!");
+				return false;
+			}
+
+			mEmittedCapacity = kWorkgroupSize;
+			if (!context.emittedBuffer->create(sizeof(GpuParticle) * mEmittedCapacity))
+			{
+				LogError("StorageBuffer::create() failed!!");
+				return false;
+			}
+
+			for (auto& particleBuffer : context.particleBuffers)
+			{
+				particleBuffer = std::make_unique<StorageBuffer>();
+				if (!particleBuffer->create(sizeof(GpuParticle) * mNumParticles, nullptr, wgpu::BufferUsage::CopySrc))
+				{
+					LogError("StorageBuffer::create() failed!!");
+					return false;
+				}
+			}
+		}
+
+		for (uint32_t idx = 0; idx < 2; idx++)
+		{
+			const std::vector<BindGroupItem> bindGroupItems =
+			{
+				{
+					.binding = 0,
+					.size = sizeof(SimulationData),
+					.resource = BufferBindingResource(*context.simulationBuffer)
+				},
+				{
+					.binding = 1,
+					.size = sizeof(GpuParticle) * mNumParticles,
+					.resource = BufferBindingResource(*context.particleBuffers[idx])
+				},
+				{
+					.binding = 2,
+					.size = sizeof(GpuParticle) * mNumParticles,
+					.resource = BufferBindingResource(*context.particleBuffers[1 - idx])
+				},
+				{
+					.binding = 3,
+					.size = sizeof(GpuParticle) * mEmittedCapacity,
+					.resource = BufferBindingResource(*context.emittedBuffer)
+				},
+				{
+					.binding = 4,
+					.size = sizeof(uint32_t) * (2 + kMaxSlots),
+					.resource = BufferBindingResource(*context.counterBuffer)
+				},
+				{
+					.binding = 5,
+					.size = sizeof(DrawArgs) * kMaxSlots,
+					.resource = BufferBindingResource(*context.drawArgsBuffer)
+				},
+				{
+					.binding = 6,
+					.size = sizeof(uint32_t) * kMaxSlots,
+					.resource = BufferBindingResource(*context.slotOffsetBuffer)
+				}
+			};
+
+			context.bindGroups[idx] = std::make_unique<BindGroup>();
+			if (!context.bindGroups[idx]->create(*context.bindGroupLayout, bindGroupItems))
+			{
+				LogError("BindGroup::create() failed!!");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool GpuParticlePool::createRenderContext(RenderTarget& renderTarget)
+	{
+		auto& context = mRenderContext;
+		ShaderPreProcessor processor;
+
+		context.shader = std::make_unique<Shader>();
+		if (!context.shader->create(kRenderShader, processor))
+		{
+			LogError("Shader::create() failed for: %s!!", kRenderShader);
+			return false;
+		}
+
+		context.sampler = std::make_unique<Sampler>();
+		if (!context.sampler->create({
+			.addressModeU = wgpu::AddressMode::Repeat,
+			.addressModeV = wgpu::AddressMode::Repeat,
+			.addressModeW = wgpu::AddressMode::Repeat,
+			.magFilter = wgpu::FilterMode::Nearest,
+			.minFilter = wgpu::FilterMode::Nearest,
+			.mipmapFilter = wgpu::MipmapFilterMode::Nearest
+		}))
+		{
+			LogError("Sampler::create() failed!!");
+			return false;
+		}
+
+		const std::vector<BindGroupLayoutItem> layoutItems =
+		{
+			{
+				.binding = 0,
+				.shaderStages = wgpu::ShaderStage::Vertex,
+				.bindingLayout = BufferBindingLayout {
+					.type = wgpu::BufferBindingType::Uniform,
+					.minBindingSize = sizeof(PerFrameData)
+				}
+			},
+			{
+				.binding = 1,
+				.shaderStages = wgpu::ShaderStage::Vertex,
+				.bindingLayout = BufferBindingLayout {
+					.type = wgpu::BufferBindingType::ReadOnlyStorage
+				}
+			},
+			{
+				.binding = 2,
+				.shaderStages = wgpu::ShaderStage::Vertex,
+				.bindingLayout = BufferBindingLayout {
+					.type = wgpu::BufferBindingType::ReadOnlyStorage
+				}
+			},
+			{
+				.binding = 3,
+				.shaderStages = wgpu::ShaderStage::Vertex,
+				.bindingLayout = BufferBindingLayout {
+					.type = wgpu::BufferBindingType::ReadOnlyStorage
+				}
+			}
+		};
+
+		const BindGroupLayoutItem slotLayoutItem = {
+			.binding = 2,
+			.shaderStages = wgpu::ShaderStage::Vertex,
+			.bindingLayout = BufferBindingLayout {
+				.type = wgpu::BufferBindingType::Uniform,
+				.minBindingSize = sizeof(SlotData)
+			}
+		};
+
+		const std::vector<BindGroupLayoutItem> texturedLayoutItems =
+		{
+			{
+				.binding = 0,
+				.shaderStages = wgpu::ShaderStage::Fragment,
+				.bindingLayout = SamplerBindingLayout {
+					.type = wgpu::SamplerBindingType::Filtering
+				}
+			},
+			{
+				.binding = 1,
+				.shaderStages = wgpu::ShaderStage::Fragment,
+				.bindingLayout = TextureBindingLayout {
+					.sampleType = wgpu::TextureSampleType::Float,
+					.viewDimension = wgpu::TextureViewDimension::e2D
+				}
+			},
+			slotLayoutItem
+		};
+
+		context.bindGroupLayout = std::make_unique<BindGroupLayout>();
+		context.texturedLayout = std::make_unique<BindGroupLayout>();
+		context.coloredLayout = std::make_unique<BindGroupLayout>();
+
+		if (!context.bindGroupLayout->create(layoutItems) ||
+			!context.texturedLayout->create(texturedLayoutItems) ||
+			!context.coloredLayout->create({ slotLayoutItem }))
+		{
+			LogError("BindGroupLayout::create() failed!!");
+			return false;
+		}
+
+		auto createPipeline = [&](std::unique_ptr<RenderPipeline>& pipeline, const char* fsEntry, 
+			const BindGroupLayout& slotLayout) {
+			RenderPipelineProperties renderProps = {
+				.shader = context.shader.get(),
+				.fsEntry = fsEntry,
+				.bindGroupLayouts = { context.bindGroupLayout.get(), &slotLayout },
+				.colorTargets = {{
+					.format = renderTarget.getColorFormat(),
+					.blendState = wgpu::BlendState {
+						.color = {
+							.operation = wgpu::BlendOperation::Add,
+							.srcFactor = wgpu::BlendFactor::SrcAlpha,
+							.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha
+						},
+						.alpha = {
+							.operation = wgpu::BlendOperation::Add,
+							.srcFactor = wgpu::BlendFactor::One,
+							.dstFactor = wgpu::BlendFactor::OneMinusSrcAlpha
+						}
+					}
+				}},
+				.primitive = {
+					.topology = wgpu::PrimitiveTopology::TriangleList,
+					.frontFace = wgpu::FrontFace::CW,
+					.cullMode = wgpu::CullMode::None
+				}
+			};
+
+			if (renderTarget.hasDepthStencilAttachment())
+			{
+				renderProps.depthStencil = {
+					.format = renderTarget.getDepthFormat()
+				};
+			}
+
+			pipeline = std::make_unique<RenderPipeline>();
+			return pipeline->create(renderProps);
+		};
+
+		if (!createPipeline(context.texturedPipeline, "fs_textured", *context.texturedLayout) ||
+			!createPipeline(context.coloredPipeline, "fs_colored", *context.coloredLayout))
+		{
+			LogError("RenderPipeline::create() failed!!");
+			return false;
+		}
+
+		context.perFrameBuffer = std::make_unique<UniformBuffer>();
+		context.frameBuffer = std::make_unique<StorageBuffer>();
+
+		if (!context.perFrameBuffer->create(sizeof(PerFrameData)) ||
+			!context.frameBuffer->create(sizeof(GpuFrame) * kMaxFrames))
+		{
+			LogError("Buffer::create() failed!!");
+			return false;
+		}
+
+		for (uint32_t idx = 0; idx < 2; idx++)
+		{
+			const std::vector<BindGroupItem> bindGroupItems =
+			{
+				{
+					.binding = 0,
+					.size = sizeof(PerFrameData),
+					.resource = BufferBindingResource(*context.perFrameBuffer)
+				},
+				{
+					.binding = 1,
+					.size = sizeof(GpuParticle) * mNumParticles,
+					.resource = BufferBindingResource(*mComputeContext.particleBuffers[idx])
+				},
+				{
+					.binding = 2,
+					.size = sizeof(GpuFrame) * kMaxFrames,
+					.resource = BufferBindingResource(*context.frameBuffer)
+				},
+				{
+					.binding = 3,
+					.size = sizeof(uint32_t) * kMaxSlots,
+					.resource = BufferBindingResource(*mComputeContext.slotOffsetBuffer)
+				}
+			};
+
+			context.bindGroups[idx] = std::make_unique<BindGroup>();
+			if (!context.bindGroups[idx]->create(*context.bindGroupLayout, bindGroupItems))
+			{
+				LogError("BindGroup::create() failed!!");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool GpuParticlePool::createSlotContext(uint32_t slot, Texture* texture)
+	{
+		auto& context = mRenderContext;
+		SlotData slotData = {
+			.slot = slot
+		};
+
+		SlotContext slotContext = {
+			.texture = texture,
+			.slotBuffer = std::make_unique<UniformBuffer>(),
+			.bindGroup = std::make_unique<BindGroup>()
+		};
+
+		if (!slotContext.slotBuffer->create(sizeof(SlotData), &slotData))
+		{
+			LogError("UniformBuffer::create() failed!!");
+			return false;
+		}
+
+		const BindGroupItem slotItem = {
+			.binding = 2,
+			.size = sizeof(SlotData),
+			.resource = BufferBindingResource(*slotContext.slotBuffer)
+		};
+
+		bool result{ false };
+		if (texture != nullptr)
+		{
+			result = slotContext.bindGroup->create(*context.texturedLayout, {
+				{
+					.binding = 0,
+					.resource = SamplerBindingResource(*context.sampler)
+				},
+				{
+					.binding = 1,
+					.resource = TextureBindingResource(*texture)
+				},
+				slotItem
+			});
+		}
+		else
+		{
+			result = slotContext.bindGroup->create(*context.coloredLayout, { slotItem });
+		}
+
+		if (!result)
+		{
+			LogError("BindGroup::create() failed!!");
+			return false;
+		}
+
+		mSlots.push_back(std::move(slotContext));
+		return true;
+	}
+
+	bool GpuParticlePool::uploadFrames()
+	{
+		const auto numFrames = std::min((uint32_t)mTextureFrames.size(), kMaxFrames);
+		if (numFrames == mNumUploadedFrames)
+		{
+			return true;
+		}
+
+		std::vector<GpuFrame> frames(numFrames);
+		mFrameSlots.resize(numFrames);
+
+		for (uint32_t idx = 0; idx < numFrames; idx++)
+		{
+			const auto& textureFrame = mTextureFrames[idx];
+			auto& frame = frames[idx];
+
+			frame.slot = getSlot(textureFrame.texture);
+			if (frame.slot == kInvalidSlot)
+			{
+				return false;
+			}
+
+			mFrameSlots[idx] = frame.slot;
+
+			if (auto* texture = textureFrame.texture; texture != nullptr)
+			{
+				const glm::vec2 invTextureSize{
+					1.0f / (float)texture->getWidth(),
+					1.0f / (float)texture->getHeight()
+				};
+
+				const auto uv1 = textureFrame.position * invTextureSize;
+				const auto uv2 = (textureFrame.position + textureFrame.size) * invTextureSize;
+
+				frame.uvRect = { uv1.x, uv1.y, uv2.x, uv2.y };
+			}
+		}
+
+		mRenderContext.frameBuffer->write(0, sizeof(GpuFrame) * numFrames, frames.data());
+		mNumUploadedFrames = numFrames;
+
+		return true;
+	}
+
+	uint32_t GpuParticlePool::getSlot(Texture* texture)
+	{
+		for (uint32_t idx = 0; idx < (uint32_t)mSlots.size(); idx++)
+		{
+			if (mSlots[idx].texture == texture)
+			{
+				return idx;
+			}
+		}
+
+		auto slot = (uint32_t)mSlots.size();
+		if (!createSlotContext(slot, texture))
+		{
+			return kInvalidSlot;
+		}
+
+		return slot;
+	}
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Particle/ParticleEffect.h"
 #include "Particle/ParticleEmitter.h"
 #include "Particle/ParticlePool.h"
+#include "Particle/GpuParticlePool.h"
 #include "Particle/Particle.h"
 #include "VFS/FileReader.h"
 #include "VFS/FileWriter.h"
@@ -84,6 +85,29 @@ namespace Trinity
 
 		mPool = std::make_unique<ParticlePool>();
 		mPool->init(poolSize);
+		mGpuPool = nullptr;
+	}
+
+	bool ParticleEffect::enableGpuSimulation(RenderTarget& renderTarget)
+	{
+		if (mGpuPool != nullptr)
+		{
+			return true;
+		}
+
+		const auto poolSize = mPool != nullptr ? mPool->getSize() : kParticlePoolSize;
+		auto gpuPool = std::make_unique<GpuParticlePool>();
+
+		if (!gpuPool->create(renderTarget, poolSize))
+		{
+			LogError("GpuParticlePool::create() failed, using CPU simulation!!");
+			return false;
+		}
+
+		mGpuPool = gpuPool.get();
+		mPool = std::move(gpuPool);
+
+		return true;
 	}
 
 	void ParticleEffect::setTransfrom(const glm::mat4& transform)
@@ -110,6 +134,14 @@ namespace Trinity
 		mPool->draw(batchRenderer, mTransform);
 	}
 
+	void ParticleEffect::draw(const RenderPass& renderPass, const glm::mat4& viewProj)
+	{
+		if (mGpuPool != nullptr)
+		{
+			mGpuPool->draw(renderPass, viewProj, mTransform);
+		}
+	}
+
 	void ParticleEditor::setParticleEffect(ParticleEffect& effect)
 	{
 		mParticle = &effect;
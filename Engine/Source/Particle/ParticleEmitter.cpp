@@ -126,8 +126,9 @@ namespace Trinity
 
 				for (uint32_t idx = 0; idx < numToEmit; idx++)
 				{
-					auto& particleSprite = particlePool.getParticleSprite();
+					Particle particleSprite;
 					initParticleSprite(particleSprite);
+					particlePool.emit(particleSprite);
 				}
 			}
 		}
@@ -137,20 +138,24 @@ namespace Trinity
 	{
 		if (mTexture != nullptr)
 		{
-			particleSprite.setTexture(*mTexture, mSrcPosition, mSrcSize);
-		}
-
-		particleSprite.setPosition(getParameterValue(mPosition));
-		particleSprite.setVelocity(getParameterValue(mVelocity));
-		particleSprite.setAcceleration(getParameterValue(mAcceleration));
-		particleSprite.setStartSize(getParameterValue(mStartSize));
-		particleSprite.setFinalSize(getParameterValue(mFinalSize));
-		particleSprite.setStartColor(getParameterValue(mStartColor));
-		particleSprite.setFinalColor(getParameterValue(mFinalColor));
-		particleSprite.setStartRotation(getParameterValue(mStartRotation));
-		particleSprite.setFinalRotation(getParameterValue(mFinalRotation));
-		particleSprite.setDrag(getParameterValue(mDrag));
-		particleSprite.setLifeSpan(getParameterValue(mLifeSpan));
+			particleSprite.textureFrame = {
+				.texture = mTexture,
+				.position = mSrcPosition,
+				.size = mSrcSize
+			};
+		}
+
+		particleSprite.position = getParameterValue(mPosition);
+		particleSprite.velocity = getParameterValue(mVelocity);
+		particleSprite.acceleration = getParameterValue(mAcceleration);
+		particleSprite.startSize = getParameterValue(mStartSize);
+		particleSprite.finalSize = getParameterValue(mFinalSize);
+		particleSprite.startColor = getParameterValue(mStartColor);
+		particleSprite.finalColor = getParameterValue(mFinalColor);
+		particleSprite.startRotation = getParameterValue(mStartRotation);
+		particleSprite.finalRotation = getParameterValue(mFinalRotation);
+		particleSprite.drag = getParameterValue(mDrag);
+		particleSprite.lifeSpan = getParameterValue(mLifeSpan);
 	}
 
 	float ParticleEmitter::getParameterValue(const FloatParticleParameter& parameter)
@@ -1,60 +1,271 @@
 #include "Particle/ParticlePool.h"
-#include "Particle/Particle.h"
+#include "Graphics/Texture.h"
+#include "Graphics/BatchRenderer.h"
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
 
 namespace Trinity
 {
-	Particle& ParticlePool::getParticleSprite()
+	void ParticlePool::init(uint32_t poolSize)
+	{
+		resize(poolSize);
+	}
+
+	void ParticlePool::emit(const Particle& particle)
 	{
 		if (mNumActive == mNumParticles)
 		{
-			resize(mNumParticles * 2);
+			resize(std::max(mNumParticles * 2, 1u));
 		}
 
-		return mParticleSprites.at(mNumActive++);
-	}
+		const auto idx = mNumActive++;
 
-	void ParticlePool::init(uint32_t poolSize)
-	{
-		resize(poolSize);
+		mFrames[idx] = getFrameIndex(particle.textureFrame);
+		mPositions[idx] = particle.position;
+		mVelocities[idx] = particle.velocity;
+		mAccelerations[idx] = particle.acceleration;
+		mStartColors[idx] = particle.startColor;
+		mFinalColors[idx] = particle.finalColor;
+		mColors[idx] = particle.startColor;
+		mStartSizes[idx] = particle.startSize;
+		mFinalSizes[idx] = particle.finalSize;
+		mSizes[idx] = particle.startSize;
+		mStartRotations[idx] = particle.startRotation;
+		mFinalRotations[idx] = particle.finalRotation;
+		mRotations[idx] = particle.startRotation;
+		mDrags[idx] = particle.drag;
+		mInvLifeSpans[idx] = particle.lifeSpan > 0.0f ? 1.0f / particle.lifeSpan : 0.0f;
+		mLifeRemaining[idx] = particle.lifeSpan;
 	}
 
 	void ParticlePool::update(float deltaTime)
 	{
-		for (uint32_t idx = 0; idx < mNumActive; idx++)
+		const auto deltaTimeSecs = deltaTime / 1000.0f;
+		auto job = [this, deltaTimeSecs](uint32_t begin, uint32_t end) {
+			integrate(begin, end, deltaTimeSecs);
+			interpolate(begin, end);
+		};
+
+		if (JobSystem::hasInstance())
+		{
+			JobSystem::get().parallelFor(mNumActive, kGrainSize, job);
+		}
+		else if (mNumActive > 0)
 		{
-			auto& sprite = mParticleSprites[idx];
-			sprite.update(deltaTime);
+			job(0, mNumActive);
 		}
 
-		for (uint32_t idx = 0; idx < mNumActive; idx++)
+		compact();
+	}
+
+	void ParticlePool::draw(BatchRenderer& renderer, const glm::mat4& rootTransform)
+	{
+		const auto* frames = mFrames.data();
+		uint32_t begin{ 0 };
+
+		while (begin < mNumActive)
 		{
-			auto& sprite = mParticleSprites[idx];
-			if (sprite.isExpired())
+			const auto frame = frames[begin];
+			auto end = begin + 1;
+
+			while (end < mNumActive && frames[end] == frame)
+			{
+				end++;
+			}
+
+			const auto& textureFrame = mTextureFrames[frame];
+			auto* vertices = renderer.allocateQuads(textureFrame.texture, end - begin);
+
+			if (vertices != nullptr)
 			{
-				if (idx != mNumActive - 1)
+				auto job = [&](uint32_t first, uint32_t last) {
+					writeVertices(begin + first, begin + last, textureFrame, rootTransform, vertices + first * 4);
+				};
+
+				if (JobSystem::hasInstance())
 				{
-					auto& lastActive = mParticleSprites[mNumActive - 1];
-					std::swap(sprite, lastActive);
+					JobSystem::get().parallelFor(end - begin, kGrainSize, job);
+				}
+				else
+				{
+					job(0, end - begin);
 				}
-
-				mNumActive--;
-				idx--;
 			}
+
+			begin = end;
 		}
 	}
 
-	void ParticlePool::draw(BatchRenderer& renderer, const glm::mat4& rootTransform)
+	void ParticlePool::resize(uint32_t newSize)
 	{
-		for (uint32_t idx = 0; idx < mNumActive; idx++)
+		mFrames.resize(newSize);
+		mPositions.resize(newSize);
+		mVelocities.resize(newSize);
+		mAccelerations.resize(newSize);
+		mStartColors.resize(newSize);
+		mFinalColors.resize(newSize);
+		mColors.resize(newSize);
+		mStartSizes.resize(newSize);
+		mFinalSizes.resize(newSize);
+		mSizes.resize(newSize);
+		mStartRotations.resize(newSize);
+		mFinalRotations.resize(newSize);
+		mRotations.resize(newSize);
+		mDrags.resize(newSize);
+		mInvLifeSpans.resize(newSize);
+		mLifeRemaining.resize(newSize);
+
+		mNumParticles = newSize;
+		mNumActive = std::min(mNumActive, newSize);
+	}
+
+	uint32_t ParticlePool::getFrameIndex(const Particle::TextureFrame& textureFrame)
+	{
+		auto it = std::find(mTextureFrames.begin(), mTextureFrames.end(), textureFrame);
+		if (it != mTextureFrames.end())
 		{
-			auto& sprite = mParticleSprites[idx];
-			sprite.draw(renderer, rootTransform);
+			return (uint32_t)(it - mTextureFrames.begin());
 		}
+
+		mTextureFrames.push_back(textureFrame);
+		return (uint32_t)mTextureFrames.size() - 1;
 	}
 
-	void ParticlePool::resize(uint32_t newSize)
+	void ParticlePool::integrate(uint32_t begin, uint32_t end, float deltaTimeSecs)
 	{
-		mParticleSprites.resize(newSize);
-		mNumParticles = newSize;
+		auto* lifeRemaining = mLifeRemaining.data();
+		for (auto idx = begin; idx < end; idx++)
+		{
+			lifeRemaining[idx] -= deltaTimeSecs;
+		}
+
+		auto* positions = mPositions.data();
+		auto* velocities = mVelocities.data();
+		const auto* accelerations = mAccelerations.data();
+		const auto* drags = mDrags.data();
+
+		for (auto idx = begin; idx < end; idx++)
+		{
+			velocities[idx] = (velocities[idx] + accelerations[idx] * deltaTimeSecs) * drags[idx];
+			positions[idx] += velocities[idx] * deltaTimeSecs;
+		}
+	}
+
+	void ParticlePool::interpolate(uint32_t begin, uint32_t end)
+	{
+		const auto* lifeRemaining = mLifeRemaining.data();
+		const auto* invLifeSpans = mInvLifeSpans.data();
+
+		const auto* startSizes = mStartSizes.data();
+		const auto* finalSizes = mFinalSizes.data();
+		const auto* startRotations = mStartRotations.data();
+		const auto* finalRotations = mFinalRotations.data();
+		auto* sizes = mSizes.data();
+		auto* rotations = mRotations.data();
+
+		for (auto idx = begin; idx < end; idx++)
+		{
+			const auto life = lifeRemaining[idx] * invLifeSpans[idx];
+			sizes[idx] = finalSizes[idx] + (startSizes[idx] - finalSizes[idx]) * life;
+			rotations[idx] = finalRotations[idx] + (startRotations[idx] - finalRotations[idx]) * life;
+		}
+
+		const auto* startColors = mStartColors.data();
+		const auto* finalColors = mFinalColors.data();
+		auto* colors = mColors.data();
+
+		for (auto idx = begin; idx < end; idx++)
+		{
+			const auto life = lifeRemaining[idx] * invLifeSpans[idx];
+			colors[idx] = finalColors[idx] + (startColors[idx] - finalColors[idx]) * life;
+		}
+	}
+
+	void ParticlePool::writeVertices(uint32_t begin, uint32_t end, const Particle::TextureFrame& textureFrame,
+		const glm::mat4& rootTransform, BatchRenderer::Vertex* vertices)
+	{
+		const glm::vec2 axisX{ rootTransform[0] };
+		const glm::vec2 axisY{ rootTransform[1] };
+		const glm::vec2 origin{ rootTransform[3] };
+
+		glm::vec2 uv1{ 0.0f };
+		glm::vec2 uv2{ 0.0f };
+
+		if (auto* texture = textureFrame.texture; texture != nullptr)
+		{
+			const glm::vec2 invTextureSize{
+				1.0f / (float)texture->getWidth(),
+				1.0f / (float)texture->getHeight()
+			};
+
+			uv1 = textureFrame.position * invTextureSize;
+			uv2 = (textureFrame.position + textureFrame.size) * invTextureSize;
+		}
+
+		const auto* positions = mPositions.data();
+		const auto* colors = mColors.data();
+		const auto* sizes = mSizes.data();
+		const auto* rotations = mRotations.data();
+
+		for (auto idx = begin; idx < end; idx++)
+		{
+			const auto halfSize = 0.5f * sizes[idx];
+			const auto cosine = std::cos(rotations[idx]) * halfSize;
+			const auto sine = std::sin(rotations[idx]) * halfSize;
+
+			const auto center = origin + axisX * positions[idx].x + axisY * positions[idx].y;
+			const auto edgeX = axisX * cosine + axisY * sine;
+			const auto edgeY = axisY * cosine - axisX * sine;
+			const auto& color = colors[idx];
+
+			vertices[0] = { .position = center - edgeX - edgeY, .uv = { uv1.x, uv2.y }, .color = color };
+			vertices[1] = { .position = center - edgeX + edgeY, .uv = { uv1.x, uv1.y }, .color = color };
+			vertices[2] = { .position = center + edgeX + edgeY, .uv = { uv2.x, uv1.y }, .color = color };
+			vertices[3] = { .position = center + edgeX - edgeY, .uv = { uv2.x, uv2.y }, .color = color };
+			vertices += 4;
+		}
+	}
+
+	void ParticlePool::compact()
+	{
+		const auto* lifeRemaining = mLifeRemaining.data();
+		uint32_t idx{ 0 };
+
+		while (idx < mNumActive)
+		{
+			if (lifeRemaining[idx] < 0.0f)
+			{
+				mNumActive--;
+				if (idx != mNumActive)
+				{
+					move(mNumActive, idx);
+				}
+			}
+			else
+			{
+				idx++;
+			}
+		}
+	}
+
+	void ParticlePool::move(uint32_t from, uint32_t to)
+	{
+		mFrames[to] = mFrames[from];
+		mPositions[to] = mPositions[from];
+		mVelocities[to] = mVelocities[from];
+		mAccelerations[to] = mAccelerations[from];
+		mStartColors[to] = mStartColors[from];
+		mFinalColors[to] = mFinalColors[from];
+		mColors[to] = mColors[from];
+		mStartSizes[to] = mStartSizes[from];
+		mFinalSizes[to] = mFinalSizes[from];
+		mSizes[to] = mSizes[from];
+		mStartRotations[to] = mStartRotations[from];
+		mFinalRotations[to] = mFinalRotations[from];
+		mRotations[to] = mRotations[from];
+		mDrags[to] = mDrags[from];
+		mInvLifeSpans[to] = mInvLifeSpans[from];
+		mLifeRemaining[to] = mLifeRemaining[from];
 	}
 }
\ No newline at end of file
@@ -0,0 +1,475 @@
+#include "Physics/DynamicTreeBroadPhase.h"
+#include <algorithm>
+
+namespace Trinity
+{
+	static BoundingRect combineBounds(const BoundingRect& a, const BoundingRect& b)
+	{
+		return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+	}
+
+	static bool isOverlapping(const BoundingRect& a, const BoundingRect& b)
+	{
+		return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+			a.min.y <= b.max.y && a.max.y >= b.min.y;
+	}
+
+	static float getPerimeter(const BoundingRect& bounds)
+	{
+		return 2.0f * ((bounds.max.x - bounds.min.x) + (bounds.max.y - bounds.min.y));
+	}
+
+	uint32_t DynamicTreeBroadPhase::createProxy(const BoundingRect& bounds, void* userData)
+	{
+		auto proxyId = allocateNode();
+		auto& node = mNodes[proxyId];
+
+		node.bounds = getFatBounds(bounds);
+		node.tightBounds = bounds;
+		node.userData = userData;
+		node.height = 0;
+
+		insertLeaf(proxyId);
+		return proxyId;
+	}
+
+	void DynamicTreeBroadPhase::destroyProxy(uint32_t proxyId)
+	{
+		if (proxyId >= (uint32_t)mNodes.size() || !mNodes[proxyId].isLeaf() || mNodes[proxyId].height < 0)
+		{
+			return;
+		}
+
+		removeLeaf(proxyId);
+		freeNode(proxyId);
+	}
+
+	void DynamicTreeBroadPhase::moveProxy(uint32_t proxyId, const BoundingRect& bounds)
+	{
+		auto& node = mNodes[proxyId];
+		node.tightBounds = bounds;
+
+		if (node.bounds.min.x <= bounds.min.x && node.bounds.min.y <= bounds.min.y &&
+			node.bounds.max.x >= bounds.max.x && node.bounds.max.y >= bounds.max.y)
+		{
+			return;
+		}
+
+		removeLeaf(proxyId);
+		mNodes[proxyId].bounds = getFatBounds(bounds);
+		insertLeaf(proxyId);
+	}
+
+	void* DynamicTreeBroadPhase::getUserData(uint32_t proxyId) const
+	{
+		return mNodes[proxyId].userData;
+	}
+
+	void DynamicTreeBroadPhase::clear()
+	{
+		mNodes.clear();
+		mRoot = kNullProxy;
+		mFreeList = kNullProxy;
+	}
+
+	void DynamicTreeBroadPhase::findPairs(std::vector<BroadPhasePair>& pairs)
+	{
+		pairs.clear();
+
+		if (mRoot == kNullProxy)
+		{
+			return;
+		}
+
+		auto& traversePairs = mTraversePairs;
+		traversePairs.clear();
+		traversePairs.push_back({ mRoot, mRoot });
+
+		while (!traversePairs.empty())
+		{
+			auto [id1, id2] = traversePairs.back();
+			traversePairs.pop_back();
+
+			const auto& node1 = mNodes[id1];
+			if (id1 == id2)
+			{
+				if (!node1.isLeaf())
+				{
+					traversePairs.push_back({ node1.child1, node1.child1 });
+					traversePairs.push_back({ node1.child2, node1.child2 });
+					traversePairs.push_back({ node1.child1, node1.child2 });
+				}
+
+				continue;
+			}
+
+			const auto& node2 = mNodes[id2];
+			if (!isOverlapping(node1.bounds, node2.bounds))
+			{
+				continue;
+			}
+
+			if (node1.isLeaf() && node2.isLeaf())
+			{
+				if (isOverlapping(node1.tightBounds, node2.tightBounds))
+				{
+					pairs.push_back({
+						.first = std::min(id1, id2),
+						.second = std::max(id1, id2)
+					});
+				}
+			}
+			else if (node2.isLeaf() || (!node1.isLeaf() && node1.height >= node2.height))
+			{
+				traversePairs.push_back({ node1.child1, id2 });
+				traversePairs.push_back({ node1.child2, id2 });
+			}
+			else
+			{
+				traversePairs.push_back({ id1, node2.child1 });
+				traversePairs.push_back({ id1, node2.child2 });
+			}
+		}
+
+		std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+			return a.first != b.first ? a.first < b.first : a.second < b.second;
+		});
+	}
+
+	void DynamicTreeBroadPhase::query(const BoundingRect& area, std::vector<uint32_t>& proxies)
+	{
+		proxies.clear();
+
+		if (mRoot == kNullProxy)
+		{
+			return;
+		}
+
+		auto& traverseNodes = mTraverseNodes;
+		traverseNodes.clear();
+		traverseNodes.push_back(mRoot);
+
+		while (!traverseNodes.empty())
+		{
+			const auto nodeId = traverseNodes.back();
+			traverseNodes.pop_back();
+
+			const auto& node = mNodes[nodeId];
+
+			if (!isOverlapping(node.bounds, area))
+			{
+				continue;
+			}
+
+			if (node.isLeaf())
+			{
+				if (isOverlapping(node.tightBounds, area))
+				{
+					proxies.push_back(nodeId);
+				}
+			}
+			else
+			{
+				traverseNodes.push_back(node.child1);
+				traverseNodes.push_back(node.child2);
+			}
+		}
+	}
+
+	void DynamicTreeBroadPhase::setMargin(float margin)
+	{
+		mMargin = margin;
+	}
+
+	uint32_t DynamicTreeBroadPhase::allocateNode()
+	{
+		if (mFreeList == kNullProxy)
+		{
+			mNodes.emplace_back();
+			return (uint32_t)mNodes.size() - 1;
+		}
+
+		auto nodeId = mFreeList;
+		mFreeList = mNodes[nodeId].parent;
+		mNodes[nodeId] = {};
+
+		return nodeId;
+	}
+
+	void DynamicTreeBroadPhase::freeNode(uint32_t nodeId)
+	{
+		mNodes[nodeId] = {};
+		mNodes[nodeId].parent = mFreeList;
+		mFreeList = nodeId;
+	}
+
+	void DynamicTreeBroadPhase::insertLeaf(uint32_t leaf)
+	{
+		if (mRoot == kNullProxy)
+		{
+			mRoot = leaf;
+			mNodes[leaf].parent = kNullProxy;
+			return;
+		}
+
+		auto leafBounds = mNodes[leaf].bounds;
+		auto sibling = mRoot;
+
+		while (!mNodes[sibling].isLeaf())
+		{
+			const auto& node = mNodes[sibling];
+			auto child1 = node.child1;
+			auto child2 = node.child2;
+
+			auto area = getPerimeter(node.bounds);
+			auto combinedArea = getPerimeter(combineBounds(node.bounds, leafBounds));
+
+			auto cost = 2.0f * combinedArea;
+			auto inheritanceCost = 2.0f * (combinedArea - area);
+
+			auto getCost = [&](uint32_t child) {
+				const auto& childNode = mNodes[child];
+				auto childCost = getPerimeter(combineBounds(leafBounds, childNode.bounds));
+
+				if (!childNode.isLeaf())
+				{
+					childCost -= getPerimeter(childNode.bounds);
+				}
+
+				return childCost + inheritanceCost;
+			};
+
+			auto cost1 = getCost(child1);
+			auto cost2 = getCost(child2);
+
+			if (cost < cost1 && cost < cost2)
+			{
+				break;
+			}
+
+			sibling = cost1 < cost2 ? child1 : child2;
+		}
+
+		auto oldParent = mNodes[sibling].parent;
+		auto newParent = allocateNode();
+
+		auto& parentNode = mNodes[newParent];
+		parentNode.parent = oldParent;
+		parentNode.bounds = combineBounds(leafBounds, mNodes[sibling].bounds);
+		parentNode.height = mNodes[sibling].height + 1;
+		parentNode.child1 = sibling;
+		parentNode.child2 = leaf;
+
+		if (oldParent != kNullProxy)
+		{
+			if (mNodes[oldParent].child1 == sibling)
+			{
+				mNodes[oldParent].child1 = newParent;
+			}
+			else
+			{
+				mNodes[oldParent].child2 = newParent;
+			}
+		}
+		else
+		{
+			mRoot = newParent;
+		}
+
+		mNodes[sibling].parent = newParent;
+		mNodes[leaf].parent = newParent;
+
+		auto nodeId = mNodes[leaf].parent;
+		while (nodeId != kNullProxy)
+		{
+			nodeId = balance(nodeId);
+
+			auto& node = mNodes[nodeId];
+			const auto& node1 = mNodes[node.child1];
+			const auto& node2 = mNodes[node.child2];
+
+			node.height = 1 + std::max(node1.height, node2.height);
+			node.bounds = combineBounds(node1.bounds, node2.bounds);
+
+			nodeId = node.parent;
+		}
+	}
+
+	void DynamicTreeBroadPhase::removeLeaf(uint32_t leaf)
+	{
+		if (leaf == mRoot)
+		{
+			mRoot = kNullProxy;
+			return;
+		}
+
+		auto parent = mNodes[leaf].parent;
+		auto grandParent = mNodes[parent].parent;
+		auto sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+		if (grandParent != kNullProxy)
+		{
+			if (mNodes[grandParent].child1 == parent)
+			{
+				mNodes[grandParent].child1 = sibling;
+			}
+			else
+			{
+				mNodes[grandParent].child2 = sibling;
+			}
+
+			mNodes[sibling].parent = grandParent;
+			freeNode(parent);
+
+			auto nodeId = grandParent;
+			while (nodeId != kNullProxy)
+			{
+				nodeId = balance(nodeId);
+
+				auto& node = mNodes[nodeId];
+				const auto& node1 = mNodes[node.child1];
+				const auto& node2 = mNodes[node.child2];
+
+				node.bounds = combineBounds(node1.bounds, node2.bounds);
+				node.height = 1 + std::max(node1.height, node2.height);
+
+				nodeId = node.parent;
+			}
+		}
+		else
+		{
+			mRoot = sibling;
+			mNodes[sibling].parent = kNullProxy;
+			freeNode(parent);
+		}
+
+		mNodes[leaf].parent = kNullProxy;
+	}
+
+	uint32_t DynamicTreeBroadPhase::balance(uint32_t nodeId)
+	{
+		auto& a = mNodes[nodeId];
+		if (a.isLeaf() || a.height < 2)
+		{
+			return nodeId;
+		}
+
+		auto iB = a.child1;
+		auto iC = a.child2;
+		auto& b = mNodes[iB];
+		auto& c = mNodes[iC];
+
+		auto diff = c.height - b.height;
+		if (diff > 1)
+		{
+			auto iF = c.child1;
+			auto iG = c.child2;
+			auto& f = mNodes[iF];
+			auto& g = mNodes[iG];
+
+			c.child1 = nodeId;
+			c.parent = a.parent;
+			a.parent = iC;
+
+			if (c.parent != kNullProxy)
+			{
+				if (mNodes[c.parent].child1 == nodeId)
+				{
+					mNodes[c.parent].child1 = iC;
+				}
+				else
+				{
+					mNodes[c.parent].child2 = iC;
+				}
+			}
+			else
+			{
+				mRoot = iC;
+			}
+
+			if (f.height > g.height)
+			{
+				c.child2 = iF;
+				a.child2 = iG;
+				g.parent = nodeId;
+				a.bounds = combineBounds(b.bounds, g.bounds);
+				c.bounds = combineBounds(a.bounds, f.bounds);
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.child2 = iG;
+				a.child2 = iF;
+				f.parent = nodeId;
+				a.bounds = combineBounds(b.bounds, f.bounds);
+				c.bounds = combineBounds(a.bounds, g.bounds);
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+
+			return iC;
+		}
+
+		if (diff < -1)
+		{
+			auto iD = b.child1;
+			auto iE = b.child2;
+			auto& d = mNodes[iD];
+			auto& e = mNodes[iE];
+
+			b.child1 = nodeId;
+			b.parent = a.parent;
+			a.parent = iB;
+
+			if (b.parent != kNullProxy)
+			{
+				if (mNodes[b.parent].child1 == nodeId)
+				{
+					mNodes[b.parent].child1 = iB;
+				}
+				else
+				{
+					mNodes[b.parent].child2 = iB;
+				}
+			}
+			else
+			{
+				mRoot = iB;
+			}
+
+			if (d.height > e.height)
+			{
+				b.child2 = iD;
+				a.child1 = iE;
+				e.parent = nodeId;
+				a.bounds = combineBounds(c.bounds, e.bounds);
+				b.bounds = combineBounds(a.bounds, d.bounds);
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.child2 = iE;
+				a.child1 = iD;
+				d.parent = nodeId;
+				a.bounds = combineBounds(c.bounds, d.bounds);
+				b.bounds = combineBounds(a.bounds, e.bounds);
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+
+			return iB;
+		}
+
+		return nodeId;
+	}
+
+	BoundingRect DynamicTreeBroadPhase::getFatBounds(const BoundingRect& bounds) const
+	{
+		return {
+			bounds.min - glm::vec2(mMargin),
+			bounds.max + glm::vec2(mMargin)
+		};
+	}
+}
\ No newline at end of file
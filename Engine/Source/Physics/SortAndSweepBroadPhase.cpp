@@ -0,0 +1,141 @@
+#include "Physics/SortAndSweepBroadPhase.h"
+#include <algorithm>
+
+namespace Trinity
+{
+	uint32_t SortAndSweepBroadPhase::createProxy(const BoundingRect& bounds, void* userData)
+	{
+		uint32_t proxyId{ 0 };
+		if (!mFreeProxies.empty())
+		{
+			proxyId = mFreeProxies.back();
+			mFreeProxies.pop_back();
+		}
+		else
+		{
+			proxyId = (uint32_t)mProxies.size();
+			mProxies.emplace_back();
+		}
+
+		auto& proxy = mProxies[proxyId];
+		proxy.bounds = bounds;
+		proxy.userData = userData;
+		proxy.active = true;
+
+		mEntries.push_back({
+			.proxyId = proxyId
+		});
+
+		return proxyId;
+	}
+
+	void SortAndSweepBroadPhase::destroyProxy(uint32_t proxyId)
+	{
+		if (proxyId >= (uint32_t)mProxies.size() || !mProxies[proxyId].active)
+		{
+			return;
+		}
+
+		mProxies[proxyId] = {};
+		mFreeProxies.push_back(proxyId);
+
+		auto it = std::find_if(mEntries.begin(), mEntries.end(), [proxyId](const auto& entry) {
+			return entry.proxyId == proxyId;
+		});
+
+		if (it != mEntries.end())
+		{
+			mEntries.erase(it);
+		}
+	}
+
+	void SortAndSweepBroadPhase::moveProxy(uint32_t proxyId, const BoundingRect& bounds)
+	{
+		mProxies[proxyId].bounds = bounds;
+	}
+
+	void* SortAndSweepBroadPhase::getUserData(uint32_t proxyId) const
+	{
+		return mProxies[proxyId].userData;
+	}
+
+	void SortAndSweepBroadPhase::clear()
+	{
+		mProxies.clear();
+		mFreeProxies.clear();
+		mEntries.clear();
+	}
+
+	void SortAndSweepBroadPhase::findPairs(std::vector<BroadPhasePair>& pairs)
+	{
+		pairs.clear();
+
+		for (auto& entry : mEntries)
+		{
+			const auto& bounds = mProxies[entry.proxyId].bounds;
+			entry.minX = bounds.min.x;
+			entry.maxX = bounds.max.x;
+			entry.minY = bounds.min.y;
+			entry.maxY = bounds.max.y;
+		}
+
+		sortEntries();
+
+		const auto numEntries = (uint32_t)mEntries.size();
+		for (uint32_t idx = 0; idx < numEntries; idx++)
+		{
+			const auto& entry = mEntries[idx];
+			for (uint32_t other = idx + 1; other < numEntries; other++)
+			{
+				const auto& otherEntry = mEntries[other];
+				if (otherEntry.minX > entry.maxX)
+				{
+					break;
+				}
+
+				if (entry.minY <= otherEntry.maxY && entry.maxY >= otherEntry.minY)
+				{
+					pairs.push_back({
+						.first = std::min(entry.proxyId, otherEntry.proxyId),
+						.second = std::max(entry.proxyId, otherEntry.proxyId)
+					});
+				}
+			}
+		}
+
+		std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+			return a.first != b.first ? a.first < b.first : a.second < b.second;
+		});
+	}
+
+	void SortAndSweepBroadPhase::sortEntries()
+	{
+		const auto numEntries = (uint32_t)mEntries.size();
+		const auto maxShifts = (size_t)numEntries * 8;
+		size_t numShifts{ 0 };
+
+		for (uint32_t idx = 1; idx < numEntries; idx++)
+		{
+			auto entry = mEntries[idx];
+			auto other = idx;
+
+			while (other > 0 && mEntries[other - 1].minX > entry.minX)
+			{
+				mEntries[other] = mEntries[other - 1];
+				other--;
+				numShifts++;
+			}
+
+			mEntries[other] = entry;
+
+			if (numShifts > maxShifts)
+			{
+				std::sort(mEntries.begin(), mEntries.end(), [](const auto& a, const auto& b) {
+					return a.minX < b.minX;
+				});
+
+				break;
+			}
+		}
+	}
+}
\ No newline at end of file
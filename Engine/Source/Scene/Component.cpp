@@ -35,6 +35,26 @@ namespace Trinity
         mNode = &node;
 	}
 
+    void Component::setHandle(const ComponentHandle& handle)
+    {
+        mHandle = handle;
+    }
+
+    void Component::operator delete(Component* ptr, std::destroying_delete_t)
+    {
+        auto* pool = ptr->mPool;
+        ptr->~Component();
+
+        if (pool != nullptr)
+        {
+            pool->deallocate(ptr);
+        }
+        else
+        {
+            ::operator delete(ptr);
+        }
+    }
+
 	void ComponentEditor::setComponent(Component& component)
 	{
         mComponent = &component;
@@ -0,0 +1,115 @@
+#include "Scene/ComponentStorage.h"
+#include "Scene/Component.h"
+
+namespace Trinity
+{
+	ComponentHandle ComponentStorage::getHandle(uint32_t denseIdx) const
+	{
+		auto sparseIdx = mDenseToSparse[denseIdx];
+		return {
+			.index = sparseIdx,
+			.generation = mGenerations[sparseIdx]
+		};
+	}
+
+	Component* ComponentStorage::getComponent(const ComponentHandle& handle) const
+	{
+		if (!contains(handle))
+		{
+			return nullptr;
+		}
+
+		return mComponents[mSparse[handle.index]].get();
+	}
+
+	bool ComponentStorage::contains(const ComponentHandle& handle) const
+	{
+		if (handle.index >= (uint32_t)mSparse.size())
+		{
+			return false;
+		}
+
+		return mSparse[handle.index] != ComponentHandle::kInvalidIndex &&
+			mGenerations[handle.index] == handle.generation;
+	}
+
+	ComponentHandle ComponentStorage::add(std::unique_ptr<Component> component)
+	{
+		uint32_t sparseIdx{ 0 };
+		if (!mFreeIndices.empty())
+		{
+			sparseIdx = mFreeIndices.back();
+			mFreeIndices.pop_back();
+		}
+		else
+		{
+			sparseIdx = (uint32_t)mSparse.size();
+			mSparse.push_back(ComponentHandle::kInvalidIndex);
+			mGenerations.push_back(0);
+		}
+
+		ComponentHandle handle = {
+			.index = sparseIdx,
+			.generation = mGenerations[sparseIdx]
+		};
+
+		component->setHandle(handle);
+
+		mSparse[sparseIdx] = (uint32_t)mComponents.size();
+		mDenseToSparse.push_back(sparseIdx);
+		mComponents.push_back(std::move(component));
+
+		return handle;
+	}
+
+	std::unique_ptr<Component> ComponentStorage::remove(const ComponentHandle& handle)
+	{
+		if (!contains(handle))
+		{
+			return nullptr;
+		}
+
+		auto denseIdx = mSparse[handle.index];
+		auto lastIdx = (uint32_t)mComponents.size() - 1;
+
+		auto component = std::move(mComponents[denseIdx]);
+		if (denseIdx != lastIdx)
+		{
+			mComponents[denseIdx] = std::move(mComponents[lastIdx]);
+			mDenseToSparse[denseIdx] = mDenseToSparse[lastIdx];
+			mSparse[mDenseToSparse[denseIdx]] = denseIdx;
+		}
+
+		mComponents.pop_back();
+		mDenseToSparse.pop_back();
+
+		mSparse[handle.index] = ComponentHandle::kInvalidIndex;
+		mGenerations[handle.index]++;
+		mFreeIndices.push_back(handle.index);
+
+		component->setHandle({});
+		return component;
+	}
+
+	void ComponentStorage::reserve(uint32_t size)
+	{
+		mComponents.reserve(size);
+		mDenseToSparse.reserve(size);
+		mSparse.reserve(size);
+		mGenerations.reserve(size);
+	}
+
+	void ComponentStorage::clear()
+	{
+		mComponents.clear();
+		mDenseToSparse.clear();
+		mFreeIndices.clear();
+
+		for (uint32_t idx = (uint32_t)mSparse.size(); idx > 0; idx--)
+		{
+			mSparse[idx - 1] = ComponentHandle::kInvalidIndex;
+			mGenerations[idx - 1]++;
+			mFreeIndices.push_back(idx - 1);
+		}
+	}
+}
\ No newline at end of file
@@ -41,9 +41,7 @@ namespace Trinity
 			return false;
 		}
 
-		mQuadTreeData = {
-			.collider = this
-		};
+		mQuadTreeData.collider = this;
 
 		return true;
 	}
@@ -70,7 +68,7 @@ namespace Trinity
 
 		for (auto* collider: colliders)
 		{
-			if (std::find(mColliders.begin(), mColliders.end(), collider) == colliders.end())
+			if (std::find(mColliders.begin(), mColliders.end(), collider) == mColliders.end())
 			{
 				onCollisionEnter.notify(*collider);
 			}
@@ -87,6 +87,15 @@ namespace Trinity
 		}
 	}
 
+	void ScriptContainer::removeScript(Script& script)
+	{
+		auto it = mScripts.find(script.getTypeUUID());
+		if (it != mScripts.end() && it->second == &script)
+		{
+			mScripts.erase(it);
+		}
+	}
+
 	void ScriptContainerEditor::setScriptContainer(ScriptContainer& scriptContainer)
 	{
 		mScriptContainer = &scriptContainer;
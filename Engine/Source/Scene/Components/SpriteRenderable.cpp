@@ -1,5 +1,6 @@
 #include "Scene/Components/SpriteRenderable.h"
 #include "Scene/Sprite.h"
+#include "Graphics/Texture.h"
 
 namespace Trinity
 {
@@ -16,25 +17,90 @@ namespace Trinity
 	void SpriteRenderable::setSprite(Sprite& sprite)
 	{
 		mSprite = &sprite;
+		mQuadCache.valid = false;
 	}
 
 	void SpriteRenderable::setOrigin(const glm::vec2& origin)
 	{
 		mOrigin = origin;
+		mQuadCache.valid = false;
 	}
 
 	void SpriteRenderable::setColor(const glm::vec4& color)
 	{
 		mColor = color;
+		mQuadCache.valid = false;
 	}
 
 	void SpriteRenderable::setFlip(const glm::bvec2& flip)
 	{
 		mFlip = flip;
+		mQuadCache.valid = false;
 	}
 
 	void SpriteRenderable::setActiveFrameIndex(uint32_t activeFrameIndex)
 	{
 		mActiveFrameIndex = activeFrameIndex;
+		mQuadCache.valid = false;
+	}
+
+	void SpriteRenderable::setLayer(uint32_t layer)
+	{
+		mLayer = layer;
+	}
+
+	void SpriteRenderable::setCullProxyId(uint32_t cullProxyId)
+	{
+		mCullProxyId = cullProxyId;
+	}
+
+	bool SpriteRenderable::isQuadValid(uint32_t worldVersion) const
+	{
+		if (!mQuadCache.valid || mQuadCache.worldVersion != worldVersion || mSprite == nullptr)
+		{
+			return false;
+		}
+
+		auto* frame = mSprite->getFrame(mActiveFrameIndex);
+		return frame != nullptr &&
+			frame->position == mQuadCache.srcPosition &&
+			frame->size == mQuadCache.srcSize &&
+			mSprite->getTexture() == mQuadCache.texture;
+	}
+
+	void SpriteRenderable::updateQuad(const glm::mat4& worldMatrix, uint32_t worldVersion)
+	{
+		auto* frame = mSprite != nullptr ? mSprite->getFrame(mActiveFrameIndex) : nullptr;
+		if (frame == nullptr)
+		{
+			mQuadCache.valid = false;
+			return;
+		}
+
+		auto* texture = mSprite->getTexture();
+
+		glm::vec2 invTextureSize{ 0.0f };
+		if (texture != nullptr)
+		{
+			invTextureSize = {
+				1.0f / (float)texture->getWidth(),
+				1.0f / (float)texture->getHeight()
+			};
+		}
+
+		auto& vertices = mQuadCache.vertices;
+		BatchRenderer::buildTextureQuad(vertices.data(), invTextureSize, frame->position, frame->size,
+			mOrigin, worldMatrix, mColor, mFlip.x, mFlip.y);
+
+		mQuadCache.bounds = {
+			glm::min(glm::min(vertices[0].position, vertices[1].position), glm::min(vertices[2].position, vertices[3].position)),
+			glm::max(glm::max(vertices[0].position, vertices[1].position), glm::max(vertices[2].position, vertices[3].position))
+		};
+
+		mQuadCache.texture = texture;
+		mQuadCache.srcPosition = frame->position;
+		mQuadCache.srcSize = frame->size;
+		mQuadCache.worldVersion = worldVersion;
+		mQuadCache.valid = true;
 	}
 }
\ No newline at end of file
@@ -59,6 +59,11 @@ namespace Trinity
 		mFlip = flip;
 	}
 
+	void TextureRenderable::setCullProxyId(uint32_t cullProxyId)
+	{
+		mCullProxyId = cullProxyId;
+	}
+
 	void TextureRenderableEditor::setTextureRenderable(TextureRenderable& renderable)
 	{
 		mTextureRenderable = &renderable;
@@ -0,0 +1,279 @@
+#include "Scene/Components/TileMapCollider.h"
+#include "Scene/Components/Transform.h"
+#include "Scene/Node.h"
+#include "TileMap/TileMap.h"
+#include "TileMap/TileLayer.h"
+#include "Physics/RectangleShape.h"
+#include <algorithm>
+
+namespace Trinity
+{
+	TileMapCollider::~TileMapCollider()
+	{
+		detachTileMap();
+	}
+
+	bool TileMapCollider::init()
+	{
+		if (mNode != nullptr)
+		{
+			setPosition(mNode->getTransform().getTranslation());
+		}
+
+		invalidate();
+		return true;
+	}
+
+	std::type_index TileMapCollider::getType() const
+	{
+		return typeid(TileMapCollider);
+	}
+
+	UUIDv4::UUID TileMapCollider::getTypeUUID() const
+	{
+		return TileMapCollider::UUID;
+	}
+
+	void TileMapCollider::setTileMap(TileMap& tileMap, uint32_t layerIdx)
+	{
+		detachTileMap();
+
+		mTileMap = &tileMap;
+		mLayerIdx = layerIdx;
+		mTileChangedId = mTileMap->onTileChanged.subscribe([this](uint32_t layerIdx, uint32_t tileIdx) {
+			if (layerIdx == mLayerIdx && mTileLayer != nullptr && mTileLayer->getVersion() == mLayerVersion + 1)
+			{
+				mLayerVersion = mTileLayer->getVersion();
+				invalidateTile(tileIdx);
+			}
+		});
+
+		mDestroyedId = mTileMap->onDestroyed.subscribe([this]() {
+			mTileMap = nullptr;
+			mTileChangedId = -1;
+			mDestroyedId = -1;
+			invalidate();
+		});
+
+		invalidate();
+	}
+
+	void TileMapCollider::detachTileMap()
+	{
+		if (mTileMap != nullptr)
+		{
+			mTileMap->onTileChanged.unsubscribe(mTileChangedId);
+			mTileMap->onDestroyed.unsubscribe(mDestroyedId);
+		}
+
+		mTileMap = nullptr;
+		mTileChangedId = -1;
+		mDestroyedId = -1;
+	}
+
+	void TileMapCollider::setPosition(const glm::vec2& position)
+	{
+		if (mPosition != position)
+		{
+			mPosition = position;
+			invalidate();
+		}
+	}
+
+	bool TileMapCollider::hasLayer(uint32_t layerIdx) const
+	{
+		return mLayers & (1 << layerIdx);
+	}
+
+	void TileMapCollider::addLayer(uint32_t layerIdx)
+	{
+		mLayers |= (1 << layerIdx);
+	}
+
+	void TileMapCollider::removeLayer(uint32_t layerIdx)
+	{
+		mLayers &= ~(1 << layerIdx);
+	}
+
+	void TileMapCollider::invalidate()
+	{
+		mTileLayer = nullptr;
+		mCells.clear();
+		mNumShapes = 0;
+	}
+
+	void TileMapCollider::invalidateTile(uint32_t tileIdx)
+	{
+		if (mNumTiles.x == 0)
+		{
+			return;
+		}
+
+		const auto cellX = (tileIdx % mNumTiles.x) / kCellSize;
+		const auto cellY = (tileIdx / mNumTiles.x) / kCellSize;
+
+		if (cellY < mNumCells.y)
+		{
+			mCells[cellY * mNumCells.x + cellX].dirty = true;
+		}
+	}
+
+	void TileMapCollider::update()
+	{
+		if (mTileMap == nullptr)
+		{
+			return;
+		}
+
+		auto* tileLayer = mTileMap->getTileLayer(mLayerIdx);
+		if (tileLayer == nullptr)
+		{
+			invalidate();
+			return;
+		}
+
+		if (tileLayer != mTileLayer || tileLayer->getVersion() != mLayerVersion ||
+			mTileMap->getNumTiles() != mNumTiles || mTileMap->getTileSize() != mTileSize)
+		{
+			mTileLayer = tileLayer;
+			mLayerVersion = tileLayer->getVersion();
+			mNumTiles = mTileMap->getNumTiles();
+			mTileSize = mTileMap->getTileSize();
+			mNumCells = {
+				(mNumTiles.x + kCellSize - 1) / kCellSize,
+				(mNumTiles.y + kCellSize - 1) / kCellSize
+			};
+
+			mCells.clear();
+			mCells.resize(mNumCells.x * mNumCells.y);
+			mNumShapes = 0;
+		}
+
+		for (uint32_t cellY = 0; cellY < mNumCells.y; cellY++)
+		{
+			for (uint32_t cellX = 0; cellX < mNumCells.x; cellX++)
+			{
+				auto& cell = mCells[cellY * mNumCells.x + cellX];
+				if (cell.dirty)
+				{
+					mNumShapes -= (uint32_t)cell.shapes.size();
+					buildCell(cellX, cellY, cell);
+					mNumShapes += (uint32_t)cell.shapes.size();
+				}
+			}
+		}
+	}
+
+	void TileMapCollider::query(const BoundingRect& area, std::vector<RigidShape*>& result) const
+	{
+		result.clear();
+
+		if (mCells.empty() || mTileSize.x <= 0.0f || mTileSize.y <= 0.0f)
+		{
+			return;
+		}
+
+		const glm::vec2 cellSize = glm::vec2{ (float)kCellSize, (float)kCellSize } * mTileSize;
+		const auto minCell = glm::floor((area.min - mPosition) / cellSize);
+		const auto maxCell = glm::floor((area.max - mPosition) / cellSize);
+
+		if (maxCell.x < 0.0f || maxCell.y < 0.0f || minCell.x >= (float)mNumCells.x || minCell.y >= (float)mNumCells.y)
+		{
+			return;
+		}
+
+		const auto beginX = (uint32_t)std::max(minCell.x, 0.0f);
+		const auto beginY = (uint32_t)std::max(minCell.y, 0.0f);
+		const auto endX = (uint32_t)std::min(maxCell.x + 1.0f, (float)mNumCells.x);
+		const auto endY = (uint32_t)std::min(maxCell.y + 1.0f, (float)mNumCells.y);
+
+		for (auto cellY = beginY; cellY < endY; cellY++)
+		{
+			for (auto cellX = beginX; cellX < endX; cellX++)
+			{
+				auto& cell = mCells[cellY * mNumCells.x + cellX];
+				for (uint32_t idx = 0; idx < (uint32_t)cell.shapes.size(); idx++)
+				{
+					if (cell.bounds[idx].isIntersecting(area))
+					{
+						result.push_back(cell.shapes[idx].get());
+					}
+				}
+			}
+		}
+	}
+
+	bool TileMapCollider::isSolid(uint32_t x, uint32_t y) const
+	{
+		return mTileLayer->getTile(y * mNumTiles.x + x) != 0;
+	}
+
+	void TileMapCollider::buildCell(uint32_t cellX, uint32_t cellY, Cell& cell)
+	{
+		const auto beginX = cellX * kCellSize;
+		const auto beginY = cellY * kCellSize;
+		const auto width = std::min(beginX + kCellSize, mNumTiles.x) - beginX;
+		const auto height = std::min(beginY + kCellSize, mNumTiles.y) - beginY;
+
+		auto& visited = mVisited;
+		visited.assign(width * height, 0);
+
+		cell.bounds.clear();
+		cell.shapes.clear();
+		cell.dirty = false;
+
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				if (visited[y * width + x] || !isSolid(beginX + x, beginY + y))
+				{
+					continue;
+				}
+
+				auto endX = x + 1;
+				while (endX < width && !visited[y * width + endX] && isSolid(beginX + endX, beginY + y))
+				{
+					endX++;
+				}
+
+				auto endY = y + 1;
+				for (; endY < height; endY++)
+				{
+					auto rowX = x;
+					while (rowX < endX && !visited[endY * width + rowX] && isSolid(beginX + rowX, beginY + endY))
+					{
+						rowX++;
+					}
+
+					if (rowX != endX)
+					{
+						break;
+					}
+				}
+
+				for (auto rowY = y; rowY < endY; rowY++)
+				{
+					std::fill_n(visited.begin() + rowY * width + x, endX - x, (uint8_t)1);
+				}
+
+				const glm::vec2 min{
+					mPosition.x + (float)(beginX + x) * mTileSize.x,
+					mPosition.y + (float)(beginY + y) * mTileSize.y
+				};
+
+				const glm::vec2 max{
+					mPosition.x + (float)(beginX + endX) * mTileSize.x,
+					mPosition.y + (float)(beginY + endY) * mTileSize.y
+				};
+
+				auto shape = std::make_unique<RectangleShape>();
+				shape->init((min + max) * 0.5f, max - min);
+				shape->setMass(0.0f);
+
+				cell.bounds.push_back({ min, max });
+				cell.shapes.push_back(std::move(shape));
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Scene/Components/Transform.h"
 #include "Scene/Node.h"
 #include "Scene/Scene.h"
+#include "Scene/TransformHierarchy.h"
 #include "Editor/EditorLayout.h"
 #include "Math/Math.h"
 #include "VFS/FileReader.h"
@@ -123,6 +124,12 @@ namespace Trinity
 	void Transform::invalidateWorldMatrix()
 	{
 		mUpdateMatrix = true;
+		mWorldVersion++;
+
+		if (mHierarchy != nullptr && mHierarchy->invalidate(mHierarchyIndex))
+		{
+			return;
+		}
 
 		auto& children = mNode->getChildren();
 		for (auto* child : children)
@@ -134,6 +141,37 @@ namespace Trinity
 
 	void Transform::updateWorldTransform()
 	{
+		if (mHierarchy != nullptr && !mHierarchy->isStructureDirty())
+		{
+			if (!mUpdateMatrix && !mHierarchy->hasPendingChanges())
+			{
+				return;
+			}
+
+			glm::mat4 parentMatrix{ 1.0f };
+			uint32_t parentVersion{ 0 };
+
+			auto parent = mNode->getParent();
+			if (parent != nullptr)
+			{
+				auto& transform = parent->getTransform();
+				parentMatrix = transform.getWorldMatrix();
+				parentVersion = transform.mWorldVersion;
+			}
+
+			if (!mUpdateMatrix && mParentVersion == parentVersion)
+			{
+				return;
+			}
+
+			mWorldMatrix = parentMatrix * getMatrix();
+			mParentVersion = parentVersion;
+			mWorldVersion++;
+			mUpdateMatrix = false;
+
+			return;
+		}
+
 		if (!mUpdateMatrix)
 		{
 			return;
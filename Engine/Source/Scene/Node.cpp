@@ -1,5 +1,6 @@
 #include "Scene/Node.h"
 #include "Scene/Scene.h"
+#include "Scene/TransformHierarchy.h"
 #include "Scene/Components/Script.h"
 #include "Scene/Components/ScriptContainer.h"
 #include "Editor/EditorLayout.h"
@@ -42,6 +43,16 @@ namespace Trinity
 
 	void Node::setParent(Node& parent)
 	{
+		if (auto* hierarchy = mTransform.getHierarchy(); hierarchy != nullptr)
+		{
+			hierarchy->invalidateStructure();
+		}
+
+		if (auto* hierarchy = parent.getTransform().getHierarchy(); hierarchy != nullptr)
+		{
+			hierarchy->invalidateStructure();
+		}
+
 		mParent = &parent;
 		mTransform.invalidateWorldMatrix();
 	}
@@ -57,6 +68,16 @@ namespace Trinity
 		return *mComponents.at(type);
 	}
 
+	Component* Node::findComponent(const std::type_index& type)
+	{
+		if (auto it = mComponents.find(type); it != mComponents.end())
+		{
+			return it->second;
+		}
+
+		return nullptr;
+	}
+
 	bool Node::hasComponent(const std::type_index& type)
 	{
 		return mComponents.contains(type);
@@ -83,6 +104,21 @@ namespace Trinity
 		}
 	}
 
+	void Node::removeComponent(Component& component)
+	{
+		if (component.getType() == typeid(Script))
+		{
+			mScriptContainer.removeScript((Script&)component);
+			return;
+		}
+
+		auto it = mComponents.find(component.getType());
+		if (it != mComponents.end() && it->second == &component)
+		{
+			mComponents.erase(it);
+		}
+	}
+
 	void NodeEditor::setScene(Scene& scene)
 	{
 		mScene = &scene;
@@ -1,4 +1,5 @@
 #include "Scene/QuadTree.h"
+#include <algorithm>
 #include <stack>
 
 namespace Trinity
@@ -41,6 +42,7 @@ namespace Trinity
 				{
 					auto childNode = std::make_unique<QuadTreeNode>();
 					childNode->bounds = childBounds[idx];
+					childNode->parent = node;
 
 					traverseNodes.push(childNode.get());
 					node->children.push_back(childNode.get());
@@ -53,100 +55,140 @@ namespace Trinity
 
 	bool QuadTree::insert(QuadTreeData& data)
 	{
-		std::stack<QuadTreeNode*> traverseNodes;
-		traverseNodes.push(mRoot);
+		removeFromLeaves(data);
+		return insert(*mRoot, data);
+	}
 
-		while (!traverseNodes.empty())
+	void QuadTree::remove(QuadTreeData& data)
+	{
+		removeFromLeaves(data);
+	}
+
+	void QuadTree::purge(std::vector<QuadTreeData*>& staleData)
+	{
+		std::sort(staleData.begin(), staleData.end());
+
+		for (auto& node : mNodes)
 		{
-			auto* node = traverseNodes.top();
-			traverseNodes.pop();
+			std::erase_if(node->contents, [&staleData](auto* data) {
+				return std::binary_search(staleData.begin(), staleData.end(), data);
+			});
+		}
+	}
 
-			if (node->bounds.collideStatus(data.bounds) != BoundCollideStatus::Outside)
-			{
-				if (node->isLeaf())
-				{
-					node->contents.push_back(&data);
-					return true;
-				}
-				else
-				{
-					for (auto* child : node->children)
-					{
-						traverseNodes.push(child);
-					}
-				}
-			}
+	void QuadTree::clear()
+	{
+		for (auto& node : mNodes)
+		{
+			node->contents.clear();
+		}
+	}
+
+	void QuadTree::update(QuadTreeData& data)
+	{
+		auto& leaves = data.leaves;
+		if (leaves.empty())
+		{
+			insert(*mRoot, data);
+			return;
+		}
+
+		if (leaves.size() == 1 && leaves[0]->bounds.contains(data.bounds))
+		{
+			return;
 		}
 
-		return false;
+		auto* start = leaves[0];
+		while (start->parent != nullptr && !start->bounds.contains(data.bounds))
+		{
+			start = start->parent;
+		}
+
+		removeFromLeaves(data);
+		insert(*start, data);
 	}
 
-	void QuadTree::remove(QuadTreeData& data)
+	void QuadTree::query(const BoundingRect& area, std::vector<QuadTreeData*>& result)
 	{
-		std::stack<QuadTreeNode*> traverseNodes;
-		traverseNodes.push(mRoot);
+		result.clear();
+		mQueryId++;
+
+		auto& traverseNodes = mTraverseNodes;
+		traverseNodes.clear();
+		traverseNodes.push_back(mRoot);
 
 		while (!traverseNodes.empty())
 		{
-			auto* node = traverseNodes.top();
-			traverseNodes.pop();
+			auto* node = traverseNodes.back();
+			traverseNodes.pop_back();
 
-			if (node->bounds.collideStatus(data.bounds) != BoundCollideStatus::Outside)
+			if (node->bounds.isIntersecting(area))
 			{
 				if (node->isLeaf())
 				{
-					auto& contents = node->contents;
-					if (auto it = std::find(contents.begin(), contents.end(), &data); it != contents.end())
+					for (auto* data : node->contents)
 					{
-						contents.erase(it);
+						if (data->queryId != mQueryId)
+						{
+							data->queryId = mQueryId;
+							result.push_back(data);
+						}
 					}
 				}
 				else
 				{
 					for (auto* child : node->children)
 					{
-						traverseNodes.push(child);
+						traverseNodes.push_back(child);
 					}
 				}
 			}
 		}
 	}
 
-	void QuadTree::update(QuadTreeData& data)
+	bool QuadTree::insert(QuadTreeNode& start, QuadTreeData& data)
 	{
-		remove(data);
-		insert(data);
-	}
-
-	void QuadTree::query(const BoundingRect& area, std::vector<QuadTreeData*>& result)
-	{
-		result.clear();
-
-		std::stack<QuadTreeNode*> traverseNodes;
-		traverseNodes.push(mRoot);
+		auto& traverseNodes = mTraverseNodes;
+		traverseNodes.clear();
+		traverseNodes.push_back(&start);
 
 		while (!traverseNodes.empty())
 		{
-			auto* node = traverseNodes.top();
-			traverseNodes.pop();
+			auto* node = traverseNodes.back();
+			traverseNodes.pop_back();
 
-			if (node->bounds.collideStatus(area) != BoundCollideStatus::Outside)
+			if (node->bounds.isIntersecting(data.bounds))
 			{
 				if (node->isLeaf())
 				{
-					for (auto* data : node->contents)
-					{
-						result.push_back(data);
-					}
+					node->contents.push_back(&data);
+					data.leaves.push_back(node);
 				}
 				else
 				{
 					for (auto* child : node->children)
 					{
-						traverseNodes.push(child);
+						traverseNodes.push_back(child);
 					}
 				}
 			}
 		}
+
+		return !data.leaves.empty();
+	}
+
+	void QuadTree::removeFromLeaves(QuadTreeData& data)
+	{
+		for (auto* leaf : data.leaves)
+		{
+			auto& contents = leaf->contents;
+			if (auto it = std::find(contents.begin(), contents.end(), &data); it != contents.end())
+			{
+				*it = contents.back();
+				contents.pop_back();
+			}
+		}
+
+		data.leaves.clear();
 	}
 }
\ No newline at end of file
@@ -21,6 +21,7 @@ namespace Trinity
 	Scene::Scene()
 	{
 		mComponentFactory = std::make_unique<ComponentFactory>();
+		mTransformHierarchy = std::make_unique<TransformHierarchy>();
 		registerDefaultComponents();
 	}
 
@@ -40,6 +41,7 @@ namespace Trinity
 
 	void Scene::clear()
 	{
+		mTransformHierarchy->setRoot(nullptr);
 		mNodes.clear();
 		mComponents.clear();
 		mRoot = nullptr;
@@ -56,7 +58,7 @@ namespace Trinity
 	bool Scene::hasComponent(const std::type_index& type) const
 	{
 		auto it = mComponents.find(type);
-		return (it != mComponents.end() && !it->second.empty());
+		return (it != mComponents.end() && !it->second.isEmpty());
 	}
 
 	Node* Scene::findNode(const std::string& name) const
@@ -93,19 +95,29 @@ namespace Trinity
 		return nullptr;
 	}
 
-	const std::vector<std::unique_ptr<Component>>& Scene::getComponents(const std::type_index& type) const
+	const ComponentStorage& Scene::getComponents(const std::type_index& type) const
 	{
 		return mComponents.at(type);
 	}
 
+	const ComponentStorage* Scene::getComponentStorage(const std::type_index& type) const
+	{
+		if (auto it = mComponents.find(type); it != mComponents.end())
+		{
+			return &it->second;
+		}
+
+		return nullptr;
+	}
+
 	Component* Scene::getComponent(const std::type_index& type) const
 	{
 		if (hasComponent(type))
 		{
 			const auto& components = getComponents(type);
-			if (components.size() > 0)
+			if (!components.isEmpty())
 			{
-				return components[0].get();
+				return components.getComponent(0u);
 			}
 		}
 
@@ -133,6 +145,8 @@ namespace Trinity
 
 	void Scene::setNodes(std::vector<std::unique_ptr<Node>> nodes)
 	{
+		mTransformHierarchy->setRoot(nullptr);
+
 		for (auto& node : nodes)
 		{
 			mNodeMap.insert(std::make_pair(node->getUUID(), node.get()));
@@ -157,9 +171,19 @@ namespace Trinity
 		mNodeMap.insert(std::make_pair(newUUID, node));
 	}
 
+	void Scene::updateTransforms()
+	{
+		if (mTransformHierarchy->getRoot() != mRoot)
+		{
+			mTransformHierarchy->setRoot(mRoot);
+		}
+
+		mTransformHierarchy->update();
+	}
+
 	void Scene::addComponent(std::unique_ptr<Component> component)
 	{
-		mComponents[component->getType()].push_back(std::move(component));
+		mComponents[component->getType()].add(std::move(component));
 	}
 
 	void Scene::addComponent(std::unique_ptr<Component> component, Node& node)
@@ -168,9 +192,32 @@ namespace Trinity
 		addComponent(std::move(component));
 	}
 
+	std::unique_ptr<Component> Scene::removeComponent(Component& component)
+	{
+		auto it = mComponents.find(component.getType());
+		if (it == mComponents.end())
+		{
+			return nullptr;
+		}
+
+		if (auto* node = component.getNode(); node != nullptr)
+		{
+			node->removeComponent(component);
+		}
+
+		return it->second.remove(component.getHandle());
+	}
+
 	void Scene::setComponents(const std::type_index& type, std::vector<std::unique_ptr<Component>> components)
 	{
-		mComponents[type] = std::move(components);
+		auto& storage = mComponents[type];
+		storage.clear();
+		storage.reserve((uint32_t)components.size());
+
+		for (auto& component : components)
+		{
+			storage.add(std::move(component));
+		}
 	}
 
 	Node* Scene::addEmpty(const glm::vec3& position, const glm::vec3& rotation, Node* parent)
@@ -202,7 +249,7 @@ namespace Trinity
 			return nullptr;
 		}
 
-		auto light = std::make_unique<Light>();		
+		auto light = Component::create<Light>();		
 		light->setName("Light");
 		light->setNode(*node);
 		light->setLightType(type);
@@ -244,7 +291,7 @@ namespace Trinity
 			return nullptr;
 		}
 
-		auto renderable = std::make_unique<TextureRenderable>();
+		auto renderable = Component::create<TextureRenderable>();
 		renderable->setName("TextureRenderable");
 		renderable->setNode(*node);
 		renderable->setTexture(texture);
@@ -266,7 +313,7 @@ namespace Trinity
 			return nullptr;
 		}
 
-		auto camera = std::make_unique<Camera>();
+		auto camera = Component::create<Camera>();
 		camera->setName("Camera");
 		camera->setNode(*node);
 		camera->setSize(size);
@@ -286,7 +333,7 @@ namespace Trinity
 			return nullptr;
 		}
 
-		auto controller = std::make_unique<CameraController>();
+		auto controller = Component::create<CameraController>();
 		controller->setName("CameraController");
 		controller->setNode(*node);
 
@@ -306,7 +353,7 @@ namespace Trinity
 			return nullptr;
 		}
 
-		auto renderable = std::make_unique<SpriteRenderable>();
+		auto renderable = Component::create<SpriteRenderable>();
 		renderable->setName("Sprite Renderable");
 		renderable->setNode(*node);
 		renderable->setSprite(sprite);
@@ -328,7 +375,7 @@ namespace Trinity
 			return nullptr;
 		}
 
-		auto animator = std::make_unique<SpriteAnimator>();
+		auto animator = Component::create<SpriteAnimator>();
 		animator->setName("Sprite Animator");
 		animator->setNode(*node);
 
@@ -427,7 +474,12 @@ namespace Trinity
 			}
 		}
 
-		const uint32_t numComponents = (uint32_t)mScene->mComponents.size();
+		uint32_t numComponents{ 0 };
+		for (auto& it : mScene->mComponents)
+		{
+			numComponents += it.second.getSize();
+		}
+
 		if (!writer.write(&numComponents))
 		{
 			LogError("FileWriter::write() failed for 'num components' for scene: '%s'", mScene->mName.c_str());
@@ -436,7 +488,7 @@ namespace Trinity
 
 		for (auto& it : mScene->mComponents)
 		{
-			auto& components = it.second;
+			auto& components = it.second.getComponents();
 			for (auto& component : components)
 			{
 				writer.writeString(component->getTypeUUID().str());
@@ -564,7 +616,7 @@ namespace Trinity
 
 		for (auto& it : mScene->mComponents)
 		{
-			auto& components = it.second;
+			auto& components = it.second.getComponents();
 			for (auto& component : components)
 			{
 				if (auto* serializer = component->getSerializer(*mScene); serializer != nullptr)
@@ -7,21 +7,46 @@
 #include "Scene/Components/TextureRenderable.h"
 #include "Scene/Components/RigidBody.h"
 #include "Scene/Components/Collider.h"
+#include "Scene/Components/TileMapCollider.h"
 #include "Graphics/Texture.h"
 #include "Graphics/BatchRenderer.h"
 #include "Graphics/RenderPass.h"
 #include "Graphics/RenderTarget.h"
 #include "Physics/Physics.h"
+#include "Physics/BroadPhase.h"
 #include "Core/ResourceCache.h"
+#include "Core/JobSystem.h"
 #include "Core/Logger.h"
+#include <algorithm>
+#include <limits>
 
 namespace Trinity
 {
+	static BoundingRect getTransformedBounds(const glm::vec2& min, const glm::vec2& max, const glm::mat4& transform)
+	{
+		const auto p1 = glm::vec2(transform * glm::vec4{ min.x, min.y, 0.0f, 1.0f });
+		const auto p2 = glm::vec2(transform * glm::vec4{ min.x, max.y, 0.0f, 1.0f });
+		const auto p3 = glm::vec2(transform * glm::vec4{ max.x, max.y, 0.0f, 1.0f });
+		const auto p4 = glm::vec2(transform * glm::vec4{ max.x, min.y, 0.0f, 1.0f });
+
+		return {
+			glm::min(glm::min(p1, p2), glm::min(p3, p4)),
+			glm::max(glm::max(p1, p2), glm::max(p3, p4))
+		};
+	}
+
+	static uint32_t getBatchLayer(uint32_t layer)
+	{
+		return std::numeric_limits<uint32_t>::max() - layer;
+	}
+
 	bool SceneSystem::create(RenderTarget& renderTarget, ResourceCache& cache)
 	{
 		mPhysics = std::make_unique<Physics>();
 		mRenderer = std::make_unique<BatchRenderer>();
 
+		setBroadPhase(std::make_unique<DynamicTreeBroadPhase>());
+
 		if (!mRenderer->create(renderTarget, cache, kTexturedShader, kColoredShader))
 		{
 			LogError("BatchRenderer::create() failed with shader: '%s' and '%s'", kTexturedShader, kColoredShader);
@@ -42,17 +67,50 @@ namespace Trinity
 	{
 		mScene = &scene;
 
-		auto rigidBodies = mScene->getComponents<RigidBody>();
-		auto colliders = mScene->getComponents<Collider>();
+		for (auto& rigidBody : mScene->view<RigidBody>())
+		{
+			rigidBody.init();
+		}
 
-		for (auto* rigidBody : rigidBodies)
+		for (auto& collider : mScene->view<Collider>())
+		{
+			auto& data = collider.getQuadTreeData();
+			data.leaves.clear();
+			data.proxyId = BroadPhase::kNullProxy;
+
+			collider.init();
+		}
+
+		for (auto& tileMapCollider : mScene->view<TileMapCollider>())
+		{
+			tileMapCollider.init();
+		}
+
+		for (auto& renderable : mScene->view<TextureRenderable>())
+		{
+			renderable.setCullProxyId(BroadPhase::kNullProxy);
+		}
+
+		for (auto& renderable : mScene->view<SpriteRenderable>())
+		{
+			renderable.setCullProxyId(BroadPhase::kNullProxy);
+		}
+
+		mTextureCull = {};
+		mSpriteCull = {};
+		mRenderBuckets.clear();
+		mRenderListEntries.clear();
+		mColliderSlots.clear();
+		mColliderProxies.clear();
+
+		if (mQuadTree != nullptr)
 		{
-			rigidBody->init();
+			mQuadTree->clear();
 		}
 
-		for (auto* collider : colliders)
+		if (mBroadPhase != nullptr)
 		{
-			collider->init();
+			mBroadPhase->clear();
 		}
 	}
 
@@ -70,47 +128,94 @@ namespace Trinity
 		}
 	}
 
+	void SceneSystem::setBroadPhase(std::unique_ptr<BroadPhase> broadPhase)
+	{
+		mBroadPhase = std::move(broadPhase);
+		mColliderProxies.clear();
+
+		if (mScene != nullptr)
+		{
+			for (auto& collider : mScene->view<Collider>())
+			{
+				collider.getQuadTreeData().proxyId = BroadPhase::kNullProxy;
+			}
+		}
+	}
+
 	void SceneSystem::setupQuadTree(const BoundingRect& sceneBounds, const BoundingRect& minBounds)
 	{
 		mQuadTree = std::make_unique<QuadTree>();
 		mQuadTree->create(minBounds, sceneBounds);
+		mColliderSlots.clear();
+
+		if (mScene != nullptr)
+		{
+			for (auto& collider : mScene->view<Collider>())
+			{
+				collider.getQuadTreeData().leaves.clear();
+			}
+		}
 	}
 
 	void SceneSystem::update(float deltaTime)
 	{
-		auto rigidBodies = mScene->getComponents<RigidBody>();
-		auto colliders = mScene->getComponents<Collider>();
+		mScene->updateTransforms();
 
-		for (auto* rigidBody : rigidBodies)
+		auto& rigidBodies = mRigidBodies;
+		rigidBodies.clear();
+
+		for (auto& rigidBody : mScene->view<RigidBody>())
 		{
-			if (!rigidBody->isKinematic())
+			if (!rigidBody.isKinematic())
 			{
-				rigidBody->update(deltaTime);
+				rigidBodies.push_back(&rigidBody);
 			}
 		}
 
-		for (auto* rigidBody : rigidBodies)
-		{
-			if (!rigidBody->isKinematic())
+		parallelFor((uint32_t)rigidBodies.size(), kRigidBodyGrainSize, [&](uint32_t begin, uint32_t end) {
+			for (auto idx = begin; idx < end; idx++)
 			{
-				rigidBody->updateTransform();
+				rigidBodies[idx]->update(deltaTime);
 			}
+		});
+
+		for (auto* rigidBody : rigidBodies)
+		{
+			rigidBody->updateTransform();
 		}
 
-		auto& physics = Physics::get();
+		auto& sceneColliders = mColliders;
+		sceneColliders.clear();
+		mPhysicsStep++;
 
-		for (uint32_t idx = 0; idx < physics.getNumRelaxations(); idx++)
+		for (auto& collider : mScene->view<Collider>())
 		{
-			for (auto* collider : colliders)
+			if (!collider.isActive())
 			{
-				updateQuadTree(*collider);
+				detachCollider(collider);
+				continue;
 			}
 
-			for (auto* collider : colliders)
-			{
-				collision(*collider);
-			}
+			trackCollider(collider);
+			sceneColliders.push_back(&collider);
+		}
+
+		sweepColliders();
+
+		for (uint32_t idx = 0; idx < (uint32_t)sceneColliders.size(); idx++)
+		{
+			auto& collider = *sceneColliders[idx];
+			collider.getQuadTreeData().index = idx;
+			collider.update();
+
+			updateQuadTree(collider);
+			updateBroadPhase(collider);
 		}
+
+		findPairs(mPairs);
+		buildIslands(mPairs);
+		collision(mPairs);
+		collideTileMaps();
 	}
 
 	void SceneSystem::draw(const RenderPass& renderPass)
@@ -126,133 +231,610 @@ namespace Trinity
 	{
 		if (mScene != nullptr)
 		{
+			mScene->updateTransforms();
+			mCullFrame++;
+
 			drawTextures(renderPass, viewProj);
 			drawSprites(renderPass, viewProj);
 		}
 	}
 
+	void SceneSystem::trackCollider(Collider& collider)
+	{
+		auto& data = collider.getQuadTreeData();
+		if (mBroadPhase != nullptr && data.proxyId != BroadPhase::kNullProxy)
+		{
+			mColliderProxySteps[data.proxyId] = mPhysicsStep;
+		}
+
+		const auto& handle = collider.getHandle();
+		if (mQuadTree == nullptr || !handle.isValid())
+		{
+			return;
+		}
+
+		auto& slots = mColliderSlots;
+		if (handle.index >= (uint32_t)slots.size())
+		{
+			slots.resize(handle.index + 1);
+		}
+
+		auto& slot = slots[handle.index];
+		if (slot.data != nullptr && slot.generation != handle.generation)
+		{
+			mStaleColliders.push_back(slot.data);
+		}
+
+		slot = {
+			.data = &data,
+			.generation = handle.generation,
+			.step = mPhysicsStep
+		};
+	}
+
+	void SceneSystem::detachCollider(Collider& collider)
+	{
+		auto& data = collider.getQuadTreeData();
+		if (mQuadTree != nullptr && !data.leaves.empty())
+		{
+			mQuadTree->remove(data);
+		}
+
+		data.proxyId = BroadPhase::kNullProxy;
+
+		const auto& handle = collider.getHandle();
+		if (handle.isValid() && handle.index < (uint32_t)mColliderSlots.size())
+		{
+			auto& slot = mColliderSlots[handle.index];
+			if (slot.generation == handle.generation)
+			{
+				slot.data = nullptr;
+			}
+		}
+	}
+
+	void SceneSystem::sweepColliders()
+	{
+		auto& proxies = mColliderProxies;
+		uint32_t numProxies{ 0 };
+
+		for (auto proxyId : proxies)
+		{
+			if (mColliderProxySteps[proxyId] == mPhysicsStep)
+			{
+				proxies[numProxies++] = proxyId;
+			}
+			else
+			{
+				mBroadPhase->destroyProxy(proxyId);
+			}
+		}
+
+		proxies.resize(numProxies);
+
+		auto& staleColliders = mStaleColliders;
+		for (auto& slot : mColliderSlots)
+		{
+			if (slot.data != nullptr && slot.step != mPhysicsStep)
+			{
+				staleColliders.push_back(slot.data);
+				slot.data = nullptr;
+			}
+		}
+
+		if (!staleColliders.empty())
+		{
+			if (mQuadTree != nullptr)
+			{
+				mQuadTree->purge(staleColliders);
+			}
+
+			staleColliders.clear();
+		}
+	}
+
 	void SceneSystem::updateQuadTree(Collider& collider)
 	{
 		if (mQuadTree != nullptr)
 		{
-			collider.update();
 			mQuadTree->update(collider.getQuadTreeData());
 		}
 	}
 
-	void SceneSystem::queryColliders(Collider& collider, std::vector<Collider*>& colliders)
+	void SceneSystem::updateBroadPhase(Collider& collider)
 	{
-		if (mQuadTree != nullptr)
+		if (mBroadPhase != nullptr)
+		{
+			auto& data = collider.getQuadTreeData();
+			if (data.proxyId == BroadPhase::kNullProxy)
+			{
+				data.proxyId = mBroadPhase->createProxy(data.bounds, &data);
+				mColliderProxies.push_back(data.proxyId);
+
+				if (data.proxyId >= (uint32_t)mColliderProxySteps.size())
+				{
+					mColliderProxySteps.resize(data.proxyId + 1);
+				}
+
+				mColliderProxySteps[data.proxyId] = mPhysicsStep;
+			}
+			else
+			{
+				mBroadPhase->moveProxy(data.proxyId, data.bounds);
+			}
+		}
+	}
+
+	void SceneSystem::findPairs(std::vector<ColliderPair>& pairs)
+	{
+		pairs.clear();
+
+		if (mBroadPhase != nullptr)
 		{
-			std::vector<QuadTreeData*> result;
-			mQuadTree->query(collider.getQuadTreeData().bounds, result);
+			mBroadPhase->findPairs(mBroadPhasePairs);
 
-			for (auto* data : result)
+			for (auto& pair : mBroadPhasePairs)
 			{
-				if (data != nullptr)
-				{	
-					auto* other = ((ColliderData*)data)->collider;
-					if (other == &collider)
-					{
-						continue;
-					}
+				auto* data1 = (ColliderData*)mBroadPhase->getUserData(pair.first);
+				auto* data2 = (ColliderData*)mBroadPhase->getUserData(pair.second);
 
-					for (uint32_t idx = 0; idx < mScene->getNumLayers(); idx++)
+				addPair(*data1->collider, *data2->collider, pairs);
+			}
+		}
+		else if (mQuadTree != nullptr)
+		{
+			for (auto* collider : mColliders)
+			{
+				auto& data = collider->getQuadTreeData();
+				mQuadTree->query(data.bounds, mQueryResult);
+
+				for (auto* result : mQueryResult)
+				{
+					auto* other = (ColliderData*)result;
+					if (other->index > data.index && other->bounds.isIntersecting(data.bounds))
 					{
-						if (other->hasLayer(idx) && collider.hasLayer(idx))
-						{
-							colliders.push_back(other);
-							break;
-						}
+						addPair(*collider, *other->collider, pairs);
 					}
 				}
 			}
 		}
 		else
 		{
-			auto others = mScene->getComponents<Collider>();
-			for (auto& other : others)
+			const auto numColliders = (uint32_t)mColliders.size();
+			for (uint32_t idx = 0; idx < numColliders; idx++)
+			{
+				auto& bounds = mColliders[idx]->getQuadTreeData().bounds;
+				for (uint32_t other = idx + 1; other < numColliders; other++)
+				{
+					if (bounds.isIntersecting(mColliders[other]->getQuadTreeData().bounds))
+					{
+						addPair(*mColliders[idx], *mColliders[other], pairs);
+					}
+				}
+			}
+		}
+
+		std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+			return a.first != b.first ? a.first < b.first : a.second < b.second;
+		});
+	}
+
+	void SceneSystem::addPair(Collider& collider1, Collider& collider2, std::vector<ColliderPair>& pairs)
+	{
+		for (uint32_t idx = 0; idx < mScene->getNumLayers(); idx++)
+		{
+			if (collider1.hasLayer(idx) && collider2.hasLayer(idx))
+			{
+				auto index1 = collider1.getQuadTreeData().index;
+				auto index2 = collider2.getQuadTreeData().index;
+
+				pairs.push_back({
+					.first = std::min(index1, index2),
+					.second = std::max(index1, index2)
+				});
+
+				break;
+			}
+		}
+	}
+
+	void SceneSystem::buildIslands(const std::vector<ColliderPair>& pairs)
+	{
+		const auto numColliders = (uint32_t)mColliders.size();
+		auto& parents = mIslandParents;
+
+		parents.resize(numColliders);
+		for (uint32_t idx = 0; idx < numColliders; idx++)
+		{
+			parents[idx] = idx;
+		}
+
+		for (auto& pair : pairs)
+		{
+			if (mColliders[pair.first]->getRigidBody()->isKinematic() ||
+				mColliders[pair.second]->getRigidBody()->isKinematic())
+			{
+				continue;
+			}
+
+			auto root1 = findIsland(pair.first);
+			auto root2 = findIsland(pair.second);
+
+			if (root1 != root2)
+			{
+				parents[std::max(root1, root2)] = std::min(root1, root2);
+			}
+		}
+
+		auto& indices = mIslandIndices;
+		auto& offsets = mIslandOffsets;
+
+		indices.assign(numColliders, BroadPhase::kNullProxy);
+		offsets.clear();
+
+		for (auto& pair : pairs)
+		{
+			auto index = mColliders[pair.first]->getRigidBody()->isKinematic() ? pair.second : pair.first;
+			auto root = findIsland(index);
+
+			if (indices[root] == BroadPhase::kNullProxy)
+			{
+				indices[root] = (uint32_t)offsets.size();
+				offsets.push_back(0);
+			}
+
+			offsets[indices[root]]++;
+		}
+
+		uint32_t offset{ 0 };
+		for (auto& count : offsets)
+		{
+			auto numPairs = count;
+			count = offset;
+			offset += numPairs;
+		}
+
+		offsets.push_back(offset);
+
+		auto& islandPairs = mIslandPairs;
+		islandPairs.resize(pairs.size());
+
+		for (uint32_t idx = 0; idx < (uint32_t)pairs.size(); idx++)
+		{
+			auto& pair = pairs[idx];
+			auto index = mColliders[pair.first]->getRigidBody()->isKinematic() ? pair.second : pair.first;
+			auto island = indices[findIsland(index)];
+
+			islandPairs[offsets[island]++] = idx;
+		}
+
+		for (auto island = (uint32_t)offsets.size() - 1; island > 1; island--)
+		{
+			offsets[island - 1] = offsets[island - 2];
+		}
+
+		offsets[0] = 0;
+	}
+
+	void SceneSystem::solveIsland(uint32_t island, const std::vector<ColliderPair>& pairs)
+	{
+		auto& physics = Physics::get();
+		const auto begin = mIslandOffsets[island];
+		const auto end = mIslandOffsets[island + 1];
+
+		for (uint32_t relaxation = 0; relaxation < physics.getNumRelaxations(); relaxation++)
+		{
+			for (auto idx = begin; idx < end; idx++)
+			{
+				auto pairIdx = mIslandPairs[idx];
+				auto& pair = pairs[pairIdx];
+
+				auto* rb1 = mColliders[pair.first]->getRigidBody();
+				auto* rb2 = mColliders[pair.second]->getRigidBody();
+
+				CollisionInfo collisionInfo{};
+				auto hit = physics.collision(*rb1->getShape(), *rb2->getShape(), collisionInfo);
+
+				if (hit && !rb1->isKinematic() && !rb2->isKinematic())
+				{
+					physics.resolve(*rb1->getShape(), *rb2->getShape(), collisionInfo);
+				}
+
+				mPairHits[pairIdx] = hit ? 1 : 0;
+			}
+		}
+	}
+
+	void SceneSystem::collision(const std::vector<ColliderPair>& pairs)
+	{
+		mPairHits.assign(pairs.size(), 0);
+
+		const auto numIslands = (uint32_t)mIslandOffsets.size() - 1;
+		parallelFor(numIslands, kIslandGrainSize, [&](uint32_t begin, uint32_t end) {
+			for (auto island = begin; island < end; island++)
+			{
+				solveIsland(island, pairs);
+			}
+		});
+
+		auto& contacts = mContacts;
+		contacts.resize(mColliders.size());
+
+		for (auto& colliders : contacts)
+		{
+			colliders.clear();
+		}
+
+		for (uint32_t idx = 0; idx < (uint32_t)pairs.size(); idx++)
+		{
+			if (mPairHits[idx])
+			{
+				auto& pair = pairs[idx];
+				contacts[pair.first].push_back(mColliders[pair.second]);
+				contacts[pair.second].push_back(mColliders[pair.first]);
+			}
+		}
+
+		for (uint32_t idx = 0; idx < (uint32_t)mColliders.size(); idx++)
+		{
+			mColliders[idx]->setColliders(std::move(contacts[idx]));
+		}
+	}
+
+	void SceneSystem::collideTileMaps()
+	{
+		auto& tileMapColliders = mTileMapColliders;
+		tileMapColliders.clear();
+
+		for (auto& tileMapCollider : mScene->view<TileMapCollider>())
+		{
+			tileMapCollider.update();
+			tileMapColliders.push_back(&tileMapCollider);
+		}
+
+		if (tileMapColliders.empty())
+		{
+			return;
+		}
+
+		auto& physics = Physics::get();
+		for (auto* collider : mColliders)
+		{
+			auto* rigidBody = collider->getRigidBody();
+			if (rigidBody->isKinematic())
+			{
+				continue;
+			}
+
+			for (auto* tileMapCollider : tileMapColliders)
 			{
-				if (other == &collider)
+				if ((collider->getLayers() & tileMapCollider->getLayers()) == 0)
 				{
 					continue;
 				}
 
-				auto* rb1 = collider.getRigidBody();
-				auto* rb2 = other->getRigidBody();
+				tileMapCollider->query(collider->getQuadTreeData().bounds, mTileShapes);
+				if (mTileShapes.empty())
+				{
+					continue;
+				}
 
-				for (uint32_t idx = 0; idx < mScene->getNumLayers(); idx++)
+				for (uint32_t relaxation = 0; relaxation < physics.getNumRelaxations(); relaxation++)
 				{
-					if (collider.hasLayer(idx) && other->hasLayer(idx))
+					for (auto* shape : mTileShapes)
 					{
-						if (rb1->getBounds().collideStatus(rb2->getBounds()) != BoundCollideStatus::Outside)
+						CollisionInfo collisionInfo{};
+						if (physics.collision(*rigidBody->getShape(), *shape, collisionInfo))
 						{
-							colliders.push_back(other);	
-							break;
+							physics.resolve(*rigidBody->getShape(), *shape, collisionInfo);
 						}
 					}
 				}
 			}
 		}
-	}	
+	}
+
+	uint32_t SceneSystem::findIsland(uint32_t index)
+	{
+		auto& parents = mIslandParents;
+		while (parents[index] != index)
+		{
+			parents[index] = parents[parents[index]];
+			index = parents[index];
+		}
+
+		return index;
+	}
+
+	void SceneSystem::parallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& job)
+	{
+		if (JobSystem::hasInstance())
+		{
+			JobSystem::get().parallelFor(count, grainSize, job);
+		}
+		else if (count > 0)
+		{
+			job(0, count);
+		}
+	}
+
+	uint32_t SceneSystem::updateCullProxy(CullContext& context, uint32_t proxyId, uint32_t order,
+		const BoundingRect& bounds, void* userData)
+	{
+		if (proxyId == BroadPhase::kNullProxy)
+		{
+			proxyId = context.tree.createProxy(bounds, userData);
+			context.proxies.push_back(proxyId);
+		}
+		else
+		{
+			context.tree.moveProxy(proxyId, bounds);
+		}
+
+		auto& entries = context.entries;
+		if (proxyId >= (uint32_t)entries.size())
+		{
+			entries.resize(proxyId + 1);
+		}
+
+		entries[proxyId] = {
+			.frame = mCullFrame,
+			.order = order
+		};
+
+		return proxyId;
+	}
+
+	void SceneSystem::sweepCullProxies(CullContext& context)
+	{
+		auto& proxies = context.proxies;
+		uint32_t numProxies{ 0 };
+
+		for (auto proxyId : proxies)
+		{
+			if (context.entries[proxyId].frame == mCullFrame)
+			{
+				proxies[numProxies++] = proxyId;
+			}
+			else
+			{
+				context.tree.destroyProxy(proxyId);
+			}
+		}
+
+		proxies.resize(numProxies);
+	}
 
-	void SceneSystem::collision(Collider& collider)
+	void SceneSystem::queryCullProxies(CullContext& context, const BoundingRect& viewBounds)
 	{
-		std::vector<Collider*> others;
-		queryColliders(collider, others);
+		context.tree.query(viewBounds, context.visible);
+
+		for (auto proxyId : context.visible)
+		{
+			context.entries[proxyId].visibleFrame = mCullFrame;
+		}
+	}
+
+	void SceneSystem::updateRenderList(uint32_t proxyId, uint32_t layer, bool isNew)
+	{
+		auto& entries = mRenderListEntries;
+		if (proxyId >= (uint32_t)entries.size())
+		{
+			entries.resize(proxyId + 1);
+		}
 
-		auto* rb1 = collider.getRigidBody();
-		auto* rs1 = rb1->getShape();
+		auto& entry = entries[proxyId];
+		if (!isNew && entry.layer == layer)
+		{
+			return;
+		}
+
+		auto& buckets = mRenderBuckets;
+		auto it = std::lower_bound(buckets.begin(), buckets.end(), layer, [](const auto& bucket, auto layer) {
+			return bucket.layer > layer;
+		});
+
+		if (it == buckets.end() || it->layer != layer)
+		{
+			it = buckets.insert(it, { .layer = layer });
+		}
+
+		entry = {
+			.layer = layer,
+			.serial = ++mRenderListSerial
+		};
+
+		it->items.push_back({
+			.proxyId = proxyId,
+			.serial = entry.serial
+		});
+	}
+
+	void SceneSystem::collectRenderList(const CullContext& context, std::vector<SpriteRenderable*>& renderables)
+	{
+		renderables.clear();
 
-		std::vector<Collider*> colliders;
-		for (auto* other : others)
+		for (auto& bucket : mRenderBuckets)
 		{
-			CollisionInfo collisionInfo{};
-			auto* rb2 = other->getRigidBody();
-			auto* rs2 = rb2->getShape();
+			auto& items = bucket.items;
+			uint32_t numItems{ 0 };
 
-			if (Physics::get().collision(*rs1, *rs2, collisionInfo))
+			for (auto& item : items)
 			{
-				colliders.push_back(other);
-				if (!rb1->isKinematic() && !rb2->isKinematic())
+				auto& entry = context.entries[item.proxyId];
+				if (entry.frame != mCullFrame || mRenderListEntries[item.proxyId].serial != item.serial)
 				{
-					Physics::get().resolve(*rs1, *rs2, collisionInfo);
+					continue;
+				}
+
+				items[numItems++] = item;
+
+				if (entry.visibleFrame == mCullFrame)
+				{
+					renderables.push_back((SpriteRenderable*)context.tree.getUserData(item.proxyId));
 				}
 			}
+
+			items.resize(numItems);
 		}
 
-		collider.setColliders(std::move(colliders));
+		std::erase_if(mRenderBuckets, [](const auto& bucket) {
+			return bucket.items.empty();
+		});
 	}
 
 	void SceneSystem::drawTextures(const RenderPass& renderPass, const glm::mat4& viewProj)
 	{
-		auto renderables = mScene->getComponents<TextureRenderable>();
-		mRenderer->begin(viewProj);
+		auto& context = mTextureCull;
+		uint32_t numRenderables{ 0 };
 
-		for (auto& renderable : renderables)
+		for (auto& renderable : mScene->view<TextureRenderable>())
 		{
-			if (!renderable->isActive())
+			auto* texture = renderable.getTexture();
+			if (!renderable.isActive() || texture == nullptr)
 			{
+				renderable.setCullProxyId(BroadPhase::kNullProxy);
 				continue;
 			}
 
-			auto* texture = renderable->getTexture();
-			auto& transform = renderable->getNode()->getTransform();
-			auto& flip = renderable->getFlip();
+			const glm::vec2 size{ texture->getWidth(), texture->getHeight() };
+			const auto& origin = renderable.getOrigin();
+			auto& transform = renderable.getNode()->getTransform();
 
-			if (texture != nullptr)
-			{
-				mRenderer->drawTexture(
-					texture,
-					glm::vec2{ 0.0f, 0.0f },
-					glm::vec2{ texture->getWidth(), texture->getHeight() },
-					renderable->getOrigin(),
-					transform.getWorldMatrix(),
-					renderable->getColor(),
-					flip.x,
-					flip.y
-				);
-			}
+			auto bounds = getTransformedBounds(-size * origin, size * (1.0f - origin), transform.getWorldMatrix());
+			renderable.setCullProxyId(updateCullProxy(context, renderable.getCullProxyId(), numRenderables++, bounds, &renderable));
+		}
+
+		sweepCullProxies(context);
+		queryCullProxies(context, getTransformedBounds(glm::vec2{ -1.0f }, glm::vec2{ 1.0f }, glm::inverse(viewProj)));
+
+		mCullStats.numVisibleTextures = (uint32_t)context.visible.size();
+		mCullStats.numCulledTextures = numRenderables - mCullStats.numVisibleTextures;
+
+		std::sort(context.visible.begin(), context.visible.end(), [&entries = context.entries](auto a, auto b) {
+			return entries[a].order < entries[b].order;
+		});
+
+		mRenderer->begin(viewProj);
+		mRenderer->setLayer(0);
+
+		for (auto proxyId : context.visible)
+		{
+			auto& renderable = *(TextureRenderable*)context.tree.getUserData(proxyId);
+			auto* texture = renderable.getTexture();
+			auto& transform = renderable.getNode()->getTransform();
+			auto& flip = renderable.getFlip();
+
+			mRenderer->drawTexture(
+				texture,
+				glm::vec2{ 0.0f, 0.0f },
+				glm::vec2{ texture->getWidth(), texture->getHeight() },
+				renderable.getOrigin(),
+				transform.getWorldMatrix(),
+				renderable.getColor(),
+				flip.x,
+				flip.y
+			);
 		}
 
 		mRenderer->end(renderPass);
@@ -260,32 +842,93 @@ namespace Trinity
 
 	void SceneSystem::drawSprites(const RenderPass& renderPass, const glm::mat4& viewProj)
 	{
-		auto renderables = mScene->getComponents<SpriteRenderable>();
-		std::sort(renderables.begin(), renderables.end(), 
-			[](const auto& a, const auto& b) {
-				return a->getLayer() > b->getLayer();
-			}
-		);
+		auto& context = mSpriteCull;
+		auto& dirtySprites = mDirtySprites;
+		auto& transforms = mSpriteTransforms;
+		uint32_t numSprites{ 0 };
 
-		mRenderer->begin(viewProj);
+		dirtySprites.clear();
+		transforms.clear();
+
+		auto updateSprite = [&](SpriteRenderable& renderable) {
+			auto proxyId = updateCullProxy(context, renderable.getCullProxyId(), numSprites++,
+				renderable.getQuadCache().bounds, &renderable);
 
-		for (auto& renderable : renderables)
+			updateRenderList(proxyId, renderable.getLayer(), renderable.getCullProxyId() == BroadPhase::kNullProxy);
+			renderable.setCullProxyId(proxyId);
+		};
+
+		for (auto& renderable : mScene->view<SpriteRenderable>())
 		{
-			auto* sprite = renderable->getSprite();
-			auto& transform = renderable->getNode()->getTransform();
-			auto& flip = renderable->getFlip();
+			auto* sprite = renderable.getSprite();
+			auto* frame = sprite != nullptr ? sprite->getFrame(renderable.getActiveFrameIndex()) : nullptr;
 
-			sprite->draw(
-				*mRenderer, 
-				renderable->getActiveFrameIndex(), 
-				renderable->getOrigin(), 
-				transform.getWorldMatrix(), 
-				renderable->getColor(), 
-				flip.x, 
-				flip.y
-			);
+			if (!renderable.isActive() || frame == nullptr)
+			{
+				renderable.setCullProxyId(BroadPhase::kNullProxy);
+				continue;
+			}
+
+			auto& transform = renderable.getNode()->getTransform();
+			if (renderable.isQuadValid(transform.getWorldVersion()))
+			{
+				updateSprite(renderable);
+				continue;
+			}
+
+			dirtySprites.push_back(&renderable);
+			transforms.push_back(transform.getWorldMatrix());
 		}
 
+		parallelFor((uint32_t)dirtySprites.size(), kSpriteGrainSize, [&](uint32_t begin, uint32_t end) {
+			for (auto idx = begin; idx < end; idx++)
+			{
+				auto* renderable = dirtySprites[idx];
+				renderable->updateQuad(transforms[idx], renderable->getNode()->getTransform().getWorldVersion());
+			}
+		});
+
+		for (auto* renderable : dirtySprites)
+		{
+			updateSprite(*renderable);
+		}
+
+		sweepCullProxies(context);
+		queryCullProxies(context, getTransformedBounds(glm::vec2{ -1.0f }, glm::vec2{ 1.0f }, glm::inverse(viewProj)));
+
+		mCullStats.numVisibleSprites = (uint32_t)context.visible.size();
+		mCullStats.numCulledSprites = numSprites - mCullStats.numVisibleSprites;
+
+		auto& renderables = mSpriteRenderables;
+		collectRenderList(context, renderables);
+
+		const auto numRenderables = (uint32_t)renderables.size();
+
+		mRenderer->begin(viewProj);
+		mRenderer->beginShards((numRenderables + kSpriteGrainSize - 1) / kSpriteGrainSize);
+
+		parallelFor(numRenderables, kSpriteGrainSize, [&](uint32_t begin, uint32_t end) {
+			const auto shardIndex = begin / kSpriteGrainSize;
+			auto layer = renderables[begin]->getLayer();
+
+			mRenderer->setShardLayer(shardIndex, getBatchLayer(layer));
+
+			for (auto idx = begin; idx < end; idx++)
+			{
+				if (renderables[idx]->getLayer() != layer)
+				{
+					layer = renderables[idx]->getLayer();
+					mRenderer->setShardLayer(shardIndex, getBatchLayer(layer));
+				}
+
+				auto& quad = renderables[idx]->getQuadCache();
+				if (quad.texture != nullptr)
+				{
+					mRenderer->drawShardQuad(shardIndex, quad.texture, quad.vertices.data());
+				}
+			}
+		});
+
 		mRenderer->end(renderPass);
 	}
 }
\ No newline at end of file
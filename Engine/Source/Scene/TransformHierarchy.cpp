@@ -0,0 +1,174 @@
+#include "Scene/TransformHierarchy.h"
+#include "Scene/Node.h"
+#include "Scene/Components/Transform.h"
+#include <algorithm>
+
+namespace Trinity
+{
+	void TransformHierarchy::setRoot(Node* root)
+	{
+		clear();
+		mRoot = root;
+	}
+
+	void TransformHierarchy::clear()
+	{
+		if (!mStructureDirty && mHasPendingChanges)
+		{
+			update();
+		}
+
+		for (auto* transform : mTransforms)
+		{
+			transform->mHierarchy = nullptr;
+			transform->mHierarchyIndex = kInvalidIndex;
+		}
+
+		mTransforms.clear();
+		mParents.clear();
+		mSubtreeEnds.clear();
+		mDirty.clear();
+		mWorldMatrices.clear();
+
+		mStructureDirty = true;
+		mHasPendingChanges = false;
+	}
+
+	void TransformHierarchy::update()
+	{
+		if (mStructureDirty)
+		{
+			rebuild();
+		}
+
+		if (!mHasPendingChanges)
+		{
+			return;
+		}
+
+		const auto size = getSize();
+		for (uint32_t idx = 0; idx < size;)
+		{
+			if (!mDirty[idx])
+			{
+				idx++;
+				continue;
+			}
+
+			updateRange(idx, mSubtreeEnds[idx]);
+			idx = mSubtreeEnds[idx];
+		}
+
+		std::fill(mDirty.begin(), mDirty.end(), (uint8_t)0);
+		mHasPendingChanges = false;
+	}
+
+	bool TransformHierarchy::invalidate(uint32_t index)
+	{
+		if (mStructureDirty || index >= getSize())
+		{
+			return false;
+		}
+
+		mDirty[index] = 1;
+		mHasPendingChanges = true;
+
+		return true;
+	}
+
+	void TransformHierarchy::invalidateStructure()
+	{
+		if (!mStructureDirty)
+		{
+			update();
+			mStructureDirty = true;
+		}
+	}
+
+	void TransformHierarchy::rebuild()
+	{
+		clear();
+
+		if (mRoot == nullptr)
+		{
+			mStructureDirty = false;
+			return;
+		}
+
+		auto& traverseNodes = mTraverseNodes;
+		traverseNodes.clear();
+		traverseNodes.push_back({ mRoot, kInvalidIndex });
+
+		while (!traverseNodes.empty())
+		{
+			auto [node, parent] = traverseNodes.back();
+			traverseNodes.pop_back();
+
+			const auto index = getSize();
+			auto& transform = node->getTransform();
+
+			transform.mHierarchy = this;
+			transform.mHierarchyIndex = index;
+
+			mTransforms.push_back(&transform);
+			mParents.push_back(parent);
+
+			auto& children = node->getChildren();
+			for (auto it = children.rbegin(); it != children.rend(); ++it)
+			{
+				traverseNodes.push_back({ *it, index });
+			}
+		}
+
+		const auto size = getSize();
+		mSubtreeEnds.resize(size);
+
+		for (uint32_t idx = 0; idx < size; idx++)
+		{
+			mSubtreeEnds[idx] = idx + 1;
+		}
+
+		for (uint32_t idx = size - 1; idx > 0; idx--)
+		{
+			auto& parentEnd = mSubtreeEnds[mParents[idx]];
+			parentEnd = std::max(parentEnd, mSubtreeEnds[idx]);
+		}
+
+		mDirty.assign(size, 0);
+		mDirty[0] = 1;
+		mWorldMatrices.resize(size);
+
+		mStructureDirty = false;
+		mHasPendingChanges = true;
+	}
+
+	void TransformHierarchy::updateRange(uint32_t begin, uint32_t end)
+	{
+		for (auto idx = begin; idx < end; idx++)
+		{
+			auto& transform = *mTransforms[idx];
+			const auto parent = mParents[idx];
+			const auto parentVersion = parent != kInvalidIndex ? mTransforms[parent]->mWorldVersion : 0;
+
+			if (!transform.mUpdateMatrix && transform.mParentVersion == parentVersion)
+			{
+				mWorldMatrices[idx] = transform.mWorldMatrix;
+				continue;
+			}
+
+			if (parent != kInvalidIndex)
+			{
+				mWorldMatrices[idx] = mWorldMatrices[parent] * transform.getMatrix();
+			}
+			else
+			{
+				mWorldMatrices[idx] = transform.getMatrix();
+			}
+
+			transform.mWorldMatrix = mWorldMatrices[idx];
+			transform.mParentVersion = parentVersion;
+			transform.mWorldVersion++;
+			transform.mUpdateMatrix = false;
+		}
+	}
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "VFS/FileReader.h"
 #include "VFS/FileWriter.h"
 #include "Core/Logger.h"
+#include <algorithm>
 
 namespace Trinity
 {
@@ -13,11 +14,26 @@ namespace Trinity
 		return &serializer;
 	}
 
-	uint32_t TileLayer::getTile(uint32_t index)
+	uint32_t TileLayer::getSize() const
 	{
+		return mStorage == TileLayerStorage::Sparse ? mNumTiles.x * mNumTiles.y : (uint32_t)mData.size();
+	}
+
+	uint32_t TileLayer::getTile(uint32_t index) const
+	{
+		if (mStorage == TileLayerStorage::Sparse)
+		{
+			if (index < mNumTiles.x * mNumTiles.y)
+			{
+				return getSparseTile(index % mNumTiles.x, index / mNumTiles.x);
+			}
+
+			return 0;
+		}
+
 		if (index < (uint32_t)mData.size())
 		{
-			return mData.at(index);
+			return mData[index];
 		}
 
 		return 0;
@@ -30,7 +46,18 @@ namespace Trinity
 
 	void TileLayer::setData(std::vector<uint32_t>&& data)
 	{
-		mData = std::move(data);
+		setDenseSize((uint32_t)data.size());
+
+		if (mStorage == TileLayerStorage::Sparse)
+		{
+			setSparseData(data);
+		}
+		else
+		{
+			mData = std::move(data);
+		}
+
+		mVersion++;
 	}
 
 	void TileLayer::setObjects(std::vector<TileObject>&& objects)
@@ -40,9 +67,18 @@ namespace Trinity
 
 	void TileLayer::setTile(uint32_t index, uint32_t id)
 	{
-		if (index < (uint32_t)mData.size())
+		if (mStorage == TileLayerStorage::Sparse)
+		{
+			if (index < mNumTiles.x * mNumTiles.y)
+			{
+				setSparseTile(index % mNumTiles.x, index / mNumTiles.x, id);
+				mVersion++;
+			}
+		}
+		else if (index < (uint32_t)mData.size())
 		{
 			mData[index] = id;
+			mVersion++;
 		}
 	}
 
@@ -51,14 +87,197 @@ namespace Trinity
 		mVisible = visible;
 	}
 
+	void TileLayer::setOffset(const glm::vec2& offset)
+	{
+		mOffset = offset;
+	}
+
+	void TileLayer::setParallax(const glm::vec2& parallax)
+	{
+		mParallax = parallax;
+	}
+
 	void TileLayer::toggleVisibility()
 	{
 		mVisible = !mVisible;
 	}
 
-	void TileLayer::resize(uint32_t newSize)
+	void TileLayer::resize(uint32_t width, uint32_t height)
+	{
+		if (mStorage == TileLayerStorage::Sparse)
+		{
+			const auto hasTiles = std::any_of(mSparseCounts.begin(), mSparseCounts.end(), [](auto count) {
+				return count > 0;
+			});
+
+			if (width != mNumTiles.x && hasTiles)
+			{
+				auto data = getDenseData();
+				data.resize(width * height, 0);
+
+				mNumTiles = { width, height };
+				setSparseData(data);
+			}
+			else
+			{
+				const auto alignedHeight = (height + kSparseChunkSize - 1) / kSparseChunkSize * kSparseChunkSize;
+				for (auto y = height; y < std::min(mNumTiles.y, alignedHeight); y++)
+				{
+					for (uint32_t x = 0; x < mNumTiles.x; x++)
+					{
+						setSparseTile(x, y, 0);
+					}
+				}
+
+				mNumTiles = { width, height };
+				mNumSparseChunks = {
+					(width + kSparseChunkSize - 1) / kSparseChunkSize,
+					(height + kSparseChunkSize - 1) / kSparseChunkSize
+				};
+
+				mSparseChunks.resize(mNumSparseChunks.x * mNumSparseChunks.y);
+				mSparseCounts.resize(mNumSparseChunks.x * mNumSparseChunks.y, 0);
+			}
+		}
+		else
+		{
+			mData.resize(width * height, 0);
+			mNumTiles = { width, height };
+		}
+
+		mVersion++;
+	}
+
+	void TileLayer::setStorage(TileLayerStorage storage)
+	{
+		if (storage == mStorage)
+		{
+			return;
+		}
+
+		if (storage == TileLayerStorage::Sparse)
+		{
+			setDenseSize((uint32_t)mData.size());
+			setSparseData(mData);
+			mData.clear();
+			mData.shrink_to_fit();
+		}
+		else
+		{
+			mData = getDenseData();
+			mSparseChunks.clear();
+			mSparseCounts.clear();
+			mNumSparseChunks = { 0, 0 };
+		}
+
+		mStorage = storage;
+		mVersion++;
+	}
+
+	uint32_t TileLayer::getSparseTile(uint32_t x, uint32_t y) const
+	{
+		const auto chunkIdx = (y / kSparseChunkSize) * mNumSparseChunks.x + x / kSparseChunkSize;
+		const auto& chunk = mSparseChunks[chunkIdx];
+
+		if (chunk.empty())
+		{
+			return 0;
+		}
+
+		return chunk[(y % kSparseChunkSize) * kSparseChunkSize + x % kSparseChunkSize];
+	}
+
+	void TileLayer::setSparseTile(uint32_t x, uint32_t y, uint32_t id)
+	{
+		const auto chunkIdx = (y / kSparseChunkSize) * mNumSparseChunks.x + x / kSparseChunkSize;
+		auto& chunk = mSparseChunks[chunkIdx];
+
+		if (chunk.empty())
+		{
+			if (id == 0)
+			{
+				return;
+			}
+
+			chunk.resize(kSparseChunkSize * kSparseChunkSize, 0);
+		}
+
+		auto& tile = chunk[(y % kSparseChunkSize) * kSparseChunkSize + x % kSparseChunkSize];
+		if (tile == 0 && id != 0)
+		{
+			mSparseCounts[chunkIdx]++;
+		}
+		else if (tile != 0 && id == 0)
+		{
+			mSparseCounts[chunkIdx]--;
+		}
+
+		tile = id;
+
+		if (mSparseCounts[chunkIdx] == 0)
+		{
+			std::vector<uint32_t>().swap(chunk);
+		}
+	}
+
+	void TileLayer::setSparseData(const std::vector<uint32_t>& data)
+	{
+		mNumSparseChunks = {
+			(mNumTiles.x + kSparseChunkSize - 1) / kSparseChunkSize,
+			(mNumTiles.y + kSparseChunkSize - 1) / kSparseChunkSize
+		};
+
+		mSparseChunks.clear();
+		mSparseChunks.resize(mNumSparseChunks.x * mNumSparseChunks.y);
+		mSparseCounts.assign(mNumSparseChunks.x * mNumSparseChunks.y, 0);
+
+		const auto numTiles = std::min((uint32_t)data.size(), mNumTiles.x * mNumTiles.y);
+		for (uint32_t idx = 0; idx < numTiles; idx++)
+		{
+			if (data[idx] != 0)
+			{
+				setSparseTile(idx % mNumTiles.x, idx / mNumTiles.x, data[idx]);
+			}
+		}
+	}
+
+	void TileLayer::setDenseSize(uint32_t size)
 	{
-		mData.resize(newSize, 0);
+		if (size != mNumTiles.x * mNumTiles.y)
+		{
+			mNumTiles = { size, size > 0 ? 1u : 0u };
+		}
+	}
+
+	std::vector<uint32_t> TileLayer::getDenseData() const
+	{
+		if (mStorage != TileLayerStorage::Sparse)
+		{
+			return mData;
+		}
+
+		std::vector<uint32_t> data(mNumTiles.x * mNumTiles.y, 0);
+		for (uint32_t chunkIdx = 0; chunkIdx < (uint32_t)mSparseChunks.size(); chunkIdx++)
+		{
+			const auto& chunk = mSparseChunks[chunkIdx];
+			if (chunk.empty())
+			{
+				continue;
+			}
+
+			const auto beginX = (chunkIdx % mNumSparseChunks.x) * kSparseChunkSize;
+			const auto beginY = (chunkIdx / mNumSparseChunks.x) * kSparseChunkSize;
+			const auto width = std::min(kSparseChunkSize, mNumTiles.x - beginX);
+			const auto height = std::min(kSparseChunkSize, mNumTiles.y - beginY);
+
+			for (uint32_t y = 0; y < height; y++)
+			{
+				const auto* src = chunk.data() + y * kSparseChunkSize;
+				std::copy(src, src + width, data.begin() + (beginY + y) * mNumTiles.x + beginX);
+			}
+		}
+
+		return data;
 	}
 
 	void TileLayerSerializer::setTileLayer(TileLayer& tileLayer)
@@ -70,12 +289,61 @@ namespace Trinity
 	{
 		mTileLayer->mName = reader.readString();
 
-		if (!reader.readVector(mTileLayer->mData))
+		uint32_t numTiles{ 0 };
+		if (!reader.read(&numTiles))
 		{
-			LogError("FileReader::readVector() failed for 'data'");
+			LogError("FileReader::read() failed for 'num tiles'");
 			return false;
 		}
 
+		uint32_t version{ 0 };
+		if (numTiles == TileLayer::kVersionMarker)
+		{
+			if (!reader.read(&version) || version > TileLayer::kVersion)
+			{
+				LogError("FileReader::read() failed for 'version'");
+				return false;
+			}
+
+			if (!reader.read(&mTileLayer->mOffset))
+			{
+				LogError("FileReader::read() failed for 'offset'");
+				return false;
+			}
+
+			if (!reader.read(&mTileLayer->mParallax))
+			{
+				LogError("FileReader::read() failed for 'parallax'");
+				return false;
+			}
+
+			if (!reader.read(&numTiles))
+			{
+				LogError("FileReader::read() failed for 'num tiles'");
+				return false;
+			}
+		}
+
+		if (numTiles == TileLayer::kSparseMarker)
+		{
+			if (!readSparseData(reader, version))
+			{
+				LogError("TileLayerSerializer::readSparseData() failed");
+				return false;
+			}
+		}
+		else
+		{
+			mTileLayer->mData.resize(numTiles);
+			if (numTiles > 0 && !reader.read(mTileLayer->mData.data(), numTiles))
+			{
+				LogError("FileReader::read() failed for 'data'");
+				return false;
+			}
+
+			mTileLayer->setDenseSize(numTiles);
+		}
+
 		uint32_t numObjects{ 0 };
 		if (!reader.read(&numObjects))
 		{
@@ -109,7 +377,36 @@ namespace Trinity
 			return false;
 		}
 
-		if (!writer.writeVector(mTileLayer->mData))
+		const auto versionMarker = TileLayer::kVersionMarker;
+		const auto version = TileLayer::kVersion;
+
+		if (!writer.write(&versionMarker) || !writer.write(&version))
+		{
+			LogError("FileWriter::write() failed for 'version'");
+			return false;
+		}
+
+		if (!writer.write(&mTileLayer->mOffset))
+		{
+			LogError("FileWriter::write() failed for 'offset'");
+			return false;
+		}
+
+		if (!writer.write(&mTileLayer->mParallax))
+		{
+			LogError("FileWriter::write() failed for 'parallax'");
+			return false;
+		}
+
+		if (mTileLayer->mStorage == TileLayerStorage::Sparse)
+		{
+			if (!writeSparseData(writer))
+			{
+				LogError("TileLayerSerializer::writeSparseData() failed");
+				return false;
+			}
+		}
+		else if (!writer.writeVector(mTileLayer->mData))
 		{
 			LogError("FileWriter::write() failed for 'data'");
 			return false;
@@ -142,7 +439,7 @@ namespace Trinity
 			return false;
 		}
 
-		if (!object.contains("data"))
+		if (!object.contains("data") && !object.contains("chunks"))
 		{
 			LogError("JSON TileLayer object doesn't have 'data' key");
 			return false;
@@ -155,7 +452,35 @@ namespace Trinity
 		}
 
 		mTileLayer->mName = object["name"].get<std::string>();
-		mTileLayer->mData = object["data"].get<std::vector<uint32_t>>();
+		if (object.contains("chunks"))
+		{
+			if (!readSparseData(object))
+			{
+				LogError("TileLayerSerializer::readSparseData() failed");
+				return false;
+			}
+		}
+		else
+		{
+			mTileLayer->mData = object["data"].get<std::vector<uint32_t>>();
+			mTileLayer->setDenseSize((uint32_t)mTileLayer->mData.size());
+		}
+
+		if (object.contains("offset"))
+		{
+			mTileLayer->mOffset = {
+				object["offset"][0].get<float>(),
+				object["offset"][1].get<float>()
+			};
+		}
+
+		if (object.contains("parallax"))
+		{
+			mTileLayer->mParallax = {
+				object["parallax"][0].get<float>(),
+				object["parallax"][1].get<float>()
+			};
+		}
 
 		for (auto& objectJson : object["objects"])
 		{
@@ -188,9 +513,31 @@ namespace Trinity
 		}
 
 		object["name"] = mTileLayer->mName;
-		object["data"] = mTileLayer->mData;
+
+		if (mTileLayer->mStorage == TileLayerStorage::Sparse)
+		{
+			if (!writeSparseData(object))
+			{
+				LogError("TileLayerSerializer::writeSparseData() failed");
+				return false;
+			}
+		}
+		else
+		{
+			object["data"] = mTileLayer->mData;
+		}
 		object["objects"] = std::move(tileObjectsJson);
 
+		object["offset"] = std::vector<float>{
+			mTileLayer->mOffset.x,
+			mTileLayer->mOffset.y
+		};
+
+		object["parallax"] = std::vector<float>{
+			mTileLayer->mParallax.x,
+			mTileLayer->mParallax.y
+		};
+
 		return true;
 	}
 
@@ -356,4 +703,363 @@ namespace Trinity
 
 		return true;
 	}
+
+	bool TileLayerSerializer::readSparseData(FileReader& reader, uint32_t version)
+	{
+		if (version < 2)
+		{
+			return readLegacySparseData(reader);
+		}
+
+		glm::uvec2 numTiles{ 0 };
+		if (!reader.read(&numTiles))
+		{
+			LogError("FileReader::read() failed for 'num tiles'");
+			return false;
+		}
+
+		uint32_t numChunks{ 0 };
+		if (!reader.read(&numChunks))
+		{
+			LogError("FileReader::read() failed for 'num chunks'");
+			return false;
+		}
+
+		mTileLayer->setStorage(TileLayerStorage::Sparse);
+		mTileLayer->resize(0, 0);
+		mTileLayer->resize(numTiles.x, numTiles.y);
+
+		std::vector<uint32_t> runs;
+		std::vector<uint32_t> tiles;
+
+		for (uint32_t idx = 0; idx < numChunks; idx++)
+		{
+			glm::uvec2 chunk{ 0 };
+			if (!reader.read(&chunk))
+			{
+				LogError("FileReader::read() failed for 'chunk position'");
+				return false;
+			}
+
+			if (!reader.readVector(runs))
+			{
+				LogError("FileReader::readVector() failed for 'chunk runs'");
+				return false;
+			}
+
+			if (!readSparseChunk(chunk.x, chunk.y, runs, tiles))
+			{
+				LogError("TileLayerSerializer::readSparseChunk() failed");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool TileLayerSerializer::readLegacySparseData(FileReader& reader)
+	{
+		uint32_t numTiles{ 0 };
+		if (!reader.read(&numTiles))
+		{
+			LogError("FileReader::read() failed for 'num tiles'");
+			return false;
+		}
+
+		uint32_t numChunks{ 0 };
+		if (!reader.read(&numChunks))
+		{
+			LogError("FileReader::read() failed for 'num chunks'");
+			return false;
+		}
+
+		std::vector<uint32_t> runs;
+		std::vector<uint32_t> tiles;
+		std::vector<uint32_t> data(numTiles, 0);
+
+		for (uint32_t idx = 0; idx < numChunks; idx++)
+		{
+			uint32_t chunkIdx{ 0 };
+			if (!reader.read(&chunkIdx))
+			{
+				LogError("FileReader::read() failed for 'chunk index'");
+				return false;
+			}
+
+			if (!reader.readVector(runs))
+			{
+				LogError("FileReader::readVector() failed for 'chunk runs'");
+				return false;
+			}
+
+			if (!readLegacySparseChunk(chunkIdx, runs, tiles, data))
+			{
+				LogError("TileLayerSerializer::readLegacySparseChunk() failed");
+				return false;
+			}
+		}
+
+		mTileLayer->setStorage(TileLayerStorage::Sparse);
+		mTileLayer->setData(std::move(data));
+
+		return true;
+	}
+
+	bool TileLayerSerializer::writeSparseData(FileWriter& writer)
+	{
+		const auto& chunks = mTileLayer->mSparseChunks;
+		const auto& numSparseChunks = mTileLayer->mNumSparseChunks;
+		const auto numChunks = (uint32_t)std::count_if(chunks.begin(), chunks.end(), [](const auto& chunk) {
+			return !chunk.empty();
+		});
+
+		if (!writer.write(&TileLayer::kSparseMarker))
+		{
+			LogError("FileWriter::write() failed for 'sparse marker'");
+			return false;
+		}
+
+		if (!writer.write(&mTileLayer->mNumTiles))
+		{
+			LogError("FileWriter::write() failed for 'num tiles'");
+			return false;
+		}
+
+		if (!writer.write(&numChunks))
+		{
+			LogError("FileWriter::write() failed for 'num chunks'");
+			return false;
+		}
+
+		for (uint32_t chunkIdx = 0; chunkIdx < (uint32_t)chunks.size(); chunkIdx++)
+		{
+			if (chunks[chunkIdx].empty())
+			{
+				continue;
+			}
+
+			const glm::uvec2 chunk{
+				chunkIdx % numSparseChunks.x,
+				chunkIdx / numSparseChunks.x
+			};
+
+			if (!writer.write(&chunk))
+			{
+				LogError("FileWriter::write() failed for 'chunk position'");
+				return false;
+			}
+
+			if (!writer.writeVector(encodeRuns(chunks[chunkIdx])))
+			{
+				LogError("FileWriter::writeVector() failed for 'chunk runs'");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool TileLayerSerializer::readSparseData(json& object)
+	{
+		if (object.contains("size"))
+		{
+			return readLegacySparseData(object);
+		}
+
+		if (!object.contains("numTiles"))
+		{
+			LogError("JSON TileLayer object doesn't have 'numTiles' key");
+			return false;
+		}
+
+		mTileLayer->setStorage(TileLayerStorage::Sparse);
+		mTileLayer->resize(0, 0);
+		mTileLayer->resize(object["numTiles"][0].get<uint32_t>(), object["numTiles"][1].get<uint32_t>());
+
+		std::vector<uint32_t> tiles;
+		for (auto& chunkJson : object["chunks"])
+		{
+			if (!chunkJson.contains("x") || !chunkJson.contains("y") || !chunkJson.contains("runs"))
+			{
+				LogError("JSON TileLayer chunk doesn't have 'x', 'y' or 'runs' key");
+				return false;
+			}
+
+			const auto chunkX = chunkJson["x"].get<uint32_t>();
+			const auto chunkY = chunkJson["y"].get<uint32_t>();
+			const auto runs = chunkJson["runs"].get<std::vector<uint32_t>>();
+
+			if (!readSparseChunk(chunkX, chunkY, runs, tiles))
+			{
+				LogError("TileLayerSerializer::readSparseChunk() failed");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool TileLayerSerializer::readLegacySparseData(json& object)
+	{
+		std::vector<uint32_t> tiles;
+		std::vector<uint32_t> data(object["size"].get<uint32_t>(), 0);
+
+		for (auto& chunkJson : object["chunks"])
+		{
+			if (!chunkJson.contains("index") || !chunkJson.contains("runs"))
+			{
+				LogError("JSON TileLayer chunk doesn't have 'index' or 'runs' key");
+				return false;
+			}
+
+			const auto chunkIdx = chunkJson["index"].get<uint32_t>();
+			const auto runs = chunkJson["runs"].get<std::vector<uint32_t>>();
+
+			if (!readLegacySparseChunk(chunkIdx, runs, tiles, data))
+			{
+				LogError("TileLayerSerializer::readLegacySparseChunk() failed");
+				return false;
+			}
+		}
+
+		mTileLayer->setStorage(TileLayerStorage::Sparse);
+		mTileLayer->setData(std::move(data));
+
+		return true;
+	}
+
+	bool TileLayerSerializer::writeSparseData(json& object)
+	{
+		const auto& chunks = mTileLayer->mSparseChunks;
+		const auto& numSparseChunks = mTileLayer->mNumSparseChunks;
+
+		json chunksJson = json::array();
+		for (uint32_t chunkIdx = 0; chunkIdx < (uint32_t)chunks.size(); chunkIdx++)
+		{
+			if (chunks[chunkIdx].empty())
+			{
+				continue;
+			}
+
+			json chunkJson;
+			chunkJson["x"] = chunkIdx % numSparseChunks.x;
+			chunkJson["y"] = chunkIdx / numSparseChunks.x;
+			chunkJson["runs"] = encodeRuns(chunks[chunkIdx]);
+
+			chunksJson.push_back(std::move(chunkJson));
+		}
+
+		object["storage"] = "sparse";
+		object["numTiles"] = std::vector<uint32_t>{
+			mTileLayer->mNumTiles.x,
+			mTileLayer->mNumTiles.y
+		};
+		object["chunks"] = std::move(chunksJson);
+
+		return true;
+	}
+
+	bool TileLayerSerializer::readSparseChunk(uint32_t chunkX, uint32_t chunkY, const std::vector<uint32_t>& runs, 
+		std::vector<uint32_t>& tiles)
+	{
+		const auto& numTiles = mTileLayer->mNumTiles;
+		const auto& numSparseChunks = mTileLayer->mNumSparseChunks;
+
+		if (chunkX >= numSparseChunks.x || chunkY >= numSparseChunks.y)
+		{
+			LogError("Invalid sparse chunk: %d, %d", chunkX, chunkY);
+			return false;
+		}
+
+		if (!decodeRuns(runs, tiles))
+		{
+			LogError("TileLayerSerializer::decodeRuns() failed");
+			return false;
+		}
+
+		const auto beginX = chunkX * TileLayer::kSparseChunkSize;
+		const auto beginY = chunkY * TileLayer::kSparseChunkSize;
+		const auto width = std::min(TileLayer::kSparseChunkSize, numTiles.x - beginX);
+		const auto height = std::min(TileLayer::kSparseChunkSize, numTiles.y - beginY);
+
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				const auto localIdx = y * TileLayer::kSparseChunkSize + x;
+				if (localIdx < (uint32_t)tiles.size())
+				{
+					mTileLayer->setSparseTile(beginX + x, beginY + y, tiles[localIdx]);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool TileLayerSerializer::readLegacySparseChunk(uint32_t chunkIdx, const std::vector<uint32_t>& runs, 
+		std::vector<uint32_t>& tiles, std::vector<uint32_t>& data)
+	{
+		constexpr auto kChunkTiles = TileLayer::kSparseChunkSize * TileLayer::kSparseChunkSize;
+
+		if (chunkIdx >= ((uint32_t)data.size() + kChunkTiles - 1) / kChunkTiles)
+		{
+			LogError("Invalid sparse chunk index: %d", chunkIdx);
+			return false;
+		}
+
+		if (!decodeRuns(runs, tiles))
+		{
+			LogError("TileLayerSerializer::decodeRuns() failed");
+			return false;
+		}
+
+		const auto begin = chunkIdx * kChunkTiles;
+		const auto end = std::min(begin + (uint32_t)tiles.size(), (uint32_t)data.size());
+		std::copy(tiles.begin(), tiles.begin() + (end - begin), data.begin() + begin);
+
+		return true;
+	}
+
+	std::vector<uint32_t> TileLayerSerializer::encodeRuns(const std::vector<uint32_t>& tiles) const
+	{
+		std::vector<uint32_t> runs;
+		for (uint32_t idx = 0; idx < (uint32_t)tiles.size();)
+		{
+			const auto value = tiles[idx];
+			uint32_t count{ 1 };
+
+			while (idx + count < (uint32_t)tiles.size() && tiles[idx + count] == value)
+			{
+				count++;
+			}
+
+			runs.push_back(count);
+			runs.push_back(value);
+			idx += count;
+		}
+
+		return runs;
+	}
+
+	bool TileLayerSerializer::decodeRuns(const std::vector<uint32_t>& runs, std::vector<uint32_t>& tiles) const
+	{
+		if (runs.size() % 2 != 0)
+		{
+			return false;
+		}
+
+		tiles.clear();
+		for (uint32_t idx = 0; idx < (uint32_t)runs.size(); idx += 2)
+		{
+			if (tiles.size() + runs[idx] > TileLayer::kSparseChunkSize * TileLayer::kSparseChunkSize)
+			{
+				return false;
+			}
+
+			tiles.insert(tiles.end(), runs[idx], runs[idx + 1]);
+		}
+
+		return true;
+	}
 }
\ No newline at end of file
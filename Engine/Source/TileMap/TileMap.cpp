@@ -1,7 +1,7 @@
 #include "TileMap/TileMap.h"
 #include "TileMap/TileLayer.h"
 #include "TileMap/TileSet.h"
-#include "Graphics/BatchRenderer.h"
+#include "Graphics/Texture.h"
 #include "Editor/EditorLayout.h"
 #include "VFS/FileReader.h"
 #include "VFS/FileWriter.h"
@@ -10,6 +10,11 @@
 
 namespace Trinity
 {
+	TileMap::~TileMap()
+	{
+		onDestroyed.notify();
+	}
+
 	std::type_index TileMap::getType() const
 	{
 		return typeid(TileMap);
@@ -86,8 +91,23 @@ namespace Trinity
 		return nullptr;
 	}
 
+	TileLayer* TileMap::getTileLayer(uint32_t index) const
+	{
+		if (index < (uint32_t)mTileLayers.size())
+		{
+			return mTileLayers.at(index).get();
+		}
+
+		return nullptr;
+	}
+
 	TileSet* TileMap::getTileSetFromId(uint32_t tileId) const
 	{
+		if (tileId < (uint32_t)mTileInfos.size())
+		{
+			return mTileInfos[tileId].tileSet;
+		}
+
 		for (auto it = mTileSets.rbegin(); it != mTileSets.rend(); it++)
 		{
 			auto& tileSet = *it;
@@ -100,6 +120,16 @@ namespace Trinity
 		return nullptr;
 	}
 
+	const TileMap::TileInfo* TileMap::getTileInfo(uint32_t tileId) const
+	{
+		if (tileId < (uint32_t)mTileInfos.size() && mTileInfos[tileId].tileSet != nullptr)
+		{
+			return &mTileInfos[tileId];
+		}
+
+		return nullptr;
+	}
+
 	uint32_t TileMap::getNextTileSetId() const
 	{
 		uint32_t nextId{ 0 };
@@ -121,15 +151,39 @@ namespace Trinity
 
 	void TileMap::setTile(uint32_t layerIdx, uint32_t tileIdx, uint32_t tileId)
 	{
-		if (layerIdx < (uint32_t)mTileLayers.size())
+		if (layerIdx >= (uint32_t)mTileLayers.size())
 		{
-			mTileLayers.at(layerIdx)->setTile(tileIdx, tileId);
+			return;
 		}
+
+		auto& tileLayer = mTileLayers.at(layerIdx);
+		const auto version = tileLayer->getVersion();
+		tileLayer->setTile(tileIdx, tileId);
+
+		if (layerIdx < (uint32_t)mLayerChunks.size() && mNumTiles.x > 0)
+		{
+			auto& layerChunks = mLayerChunks[layerIdx];
+			if (layerChunks.tileLayer == tileLayer.get() && layerChunks.version == version)
+			{
+				const auto numChunks = getNumChunks();
+				const auto chunkX = (tileIdx % mNumTiles.x) / kChunkSize;
+				const auto chunkY = (tileIdx / mNumTiles.x) / kChunkSize;
+
+				if (chunkY < numChunks.y)
+				{
+					layerChunks.chunks[chunkY * numChunks.x + chunkX].dirty = true;
+					layerChunks.version = tileLayer->getVersion();
+				}
+			}
+		}
+
+		onTileChanged.notify(layerIdx, tileIdx);
 	}
 
 	void TileMap::setTileSize(const glm::vec2& tileSize)
 	{
 		mTileSize = tileSize;
+		invalidateChunks();
 	}
 
 	void TileMap::setSize(const glm::vec2& size)
@@ -140,18 +194,21 @@ namespace Trinity
 	void TileMap::setNumTiles(const glm::uvec2& numTiles)
 	{
 		mNumTiles = numTiles;
+		invalidateChunks();
 	}
 
 	void TileMap::addTileSet(std::unique_ptr<TileSet> tileSet)
 	{
 		mTileSets.push_back(std::move(tileSet));
+		buildTileInfos();
+		invalidateChunks();
 	}
 
 	void TileMap::addTileLayer(std::unique_ptr<TileLayer> tileLayer)
 	{
 		if (mNumTiles.x > 0 && mNumTiles.y > 0)
 		{
-			tileLayer->resize(mNumTiles.x * mNumTiles.y);
+			tileLayer->resize(mNumTiles.x, mNumTiles.y);
 		}
 
 		mTileLayers.push_back(std::move(tileLayer));
@@ -162,6 +219,8 @@ namespace Trinity
 		if (tileSetIndex < (uint32_t)mTileSets.size())
 		{
 			mTileSets.erase(mTileSets.begin() + tileSetIndex);
+			buildTileInfos();
+			invalidateChunks();
 		}
 	}
 
@@ -178,6 +237,8 @@ namespace Trinity
 		if (from < (uint32_t)mTileSets.size() && to < (uint32_t)mTileSets.size())
 		{
 			std::swap(mTileSets[from], mTileSets[to]);
+			buildTileInfos();
+			invalidateChunks();
 		}
 	}
 
@@ -189,45 +250,263 @@ namespace Trinity
 		}
 	}
 
+	void TileMap::invalidateChunks()
+	{
+		mLayerChunks.clear();
+	}
+
 	void TileMap::draw(BatchRenderer& batchRenderer, const glm::vec2& position,
 		float left, float bottom, float right, float top)
 	{
-		for (auto& tileLayer : mTileLayers)
+		if (mNumTiles.x == 0 || mNumTiles.y == 0 || mTileSize.x <= 0.0f || mTileSize.y <= 0.0f)
+		{
+			return;
+		}
+
+		uint32_t tileSetVersion{ (uint32_t)mTileSets.size() };
+		for (auto& tileSet : mTileSets)
 		{
-			if (!tileLayer->isVisible())
+			tileSetVersion += tileSet->getVersion();
+		}
+
+		if (tileSetVersion != mTileSetVersion)
+		{
+			mTileSetVersion = tileSetVersion;
+			buildTileInfos();
+			invalidateChunks();
+		}
+
+		const auto numChunks = getNumChunks();
+		const glm::vec2 viewCenter{ (left + right) * 0.5f, (bottom + top) * 0.5f };
+
+		for (uint32_t layerIdx = 0; layerIdx < (uint32_t)mTileLayers.size(); layerIdx++)
+		{
+			auto& tileLayer = *mTileLayers[layerIdx];
+			if (!tileLayer.isVisible())
 			{
 				continue;
 			}
 
-			const auto& tileData = tileLayer->getData();
-			for (uint32_t idx = 0; idx < (uint32_t)tileData.size(); idx++)
+			const auto layerPosition = position + tileLayer.getOffset() + 
+				viewCenter * (1.0f - tileLayer.getParallax());
+
+			glm::uvec2 beginTile{ 0 };
+			glm::uvec2 endTile{ 0 };
+
+			if (!getVisibleTiles(layerPosition, left, bottom, right, top, beginTile, endTile))
+			{
+				continue;
+			}
+
+			const auto beginChunk = beginTile / kChunkSize;
+			const auto endChunk = (endTile + (kChunkSize - 1)) / kChunkSize;
+
+			auto& layerChunks = getLayerChunks(layerIdx);
+			for (uint32_t chunkY = beginChunk.y; chunkY < endChunk.y; chunkY++)
+			{
+				for (uint32_t chunkX = beginChunk.x; chunkX < endChunk.x; chunkX++)
+				{
+					auto& chunk = layerChunks.chunks[chunkY * numChunks.x + chunkX];
+					if (chunk.dirty)
+					{
+						buildChunk(tileLayer, chunkX, chunkY, chunk);
+					}
+
+					drawChunk(batchRenderer, layerPosition, chunk);
+				}
+			}
+		}
+	}
+
+	bool TileMap::getVisibleTiles(const glm::vec2& position, float left, float bottom, float right, float top,
+		glm::uvec2& beginTile, glm::uvec2& endTile) const
+	{
+		if (mNumTiles.x == 0 || mNumTiles.y == 0 || mTileSize.x <= 0.0f || mTileSize.y <= 0.0f)
+		{
+			return false;
+		}
+
+		const auto minTile = glm::floor((glm::vec2{ left, bottom } - position) / mTileSize);
+		const auto maxTile = glm::floor((glm::vec2{ right, top } - position) / mTileSize);
+
+		if (maxTile.x < 0.0f || maxTile.y < 0.0f || minTile.x >= (float)mNumTiles.x || minTile.y >= (float)mNumTiles.y)
+		{
+			return false;
+		}
+
+		beginTile = {
+			(uint32_t)std::max(minTile.x, 0.0f),
+			(uint32_t)std::max(minTile.y, 0.0f)
+		};
+
+		endTile = {
+			(uint32_t)std::min(maxTile.x + 1.0f, (float)mNumTiles.x),
+			(uint32_t)std::min(maxTile.y + 1.0f, (float)mNumTiles.y)
+		};
+
+		return true;
+	}
+
+	void TileMap::buildTileInfos()
+	{
+		uint32_t numTileInfos{ 0 };
+		for (auto& tileSet : mTileSets)
+		{
+			const auto& numTiles = tileSet->getNumTiles();
+			numTileInfos = std::max(numTileInfos, tileSet->getFirstId() + numTiles.x * numTiles.y);
+		}
+
+		mTileInfos.assign(numTileInfos, {});
+
+		for (uint32_t tileId = 0; tileId < numTileInfos; tileId++)
+		{
+			for (auto it = mTileSets.rbegin(); it != mTileSets.rend(); it++)
+			{
+				auto& tileSet = *it;
+				if (tileSet->getFirstId() <= tileId)
+				{
+					const auto& numTiles = tileSet->getNumTiles();
+					mTileInfos[tileId] = {
+						.tileSet = tileSet.get(),
+						.srcPosition = numTiles.x > 0 && numTiles.y > 0 ? tileSet->getPosition(tileId) : glm::vec2{ 0.0f }
+					};
+
+					break;
+				}
+			}
+		}
+	}
+
+	glm::uvec2 TileMap::getNumChunks() const
+	{
+		return {
+			(mNumTiles.x + kChunkSize - 1) / kChunkSize,
+			(mNumTiles.y + kChunkSize - 1) / kChunkSize
+		};
+	}
+
+	TileMap::LayerChunks& TileMap::getLayerChunks(uint32_t layerIdx)
+	{
+		if (mLayerChunks.size() != mTileLayers.size())
+		{
+			mLayerChunks.resize(mTileLayers.size());
+		}
+
+		auto& layerChunks = mLayerChunks[layerIdx];
+		const auto* tileLayer = mTileLayers[layerIdx].get();
+
+		if (layerChunks.tileLayer != tileLayer || layerChunks.version != tileLayer->getVersion() ||
+			layerChunks.chunks.empty())
+		{
+			const auto numChunks = getNumChunks();
+
+			layerChunks.tileLayer = tileLayer;
+			layerChunks.version = tileLayer->getVersion();
+			layerChunks.chunks.resize(numChunks.x * numChunks.y);
+
+			for (auto& chunk : layerChunks.chunks)
+			{
+				chunk.dirty = true;
+			}
+		}
+
+		return layerChunks;
+	}
+
+	void TileMap::buildChunk(const TileLayer& tileLayer, uint32_t chunkX, uint32_t chunkY, TileChunk& chunk)
+	{
+		const auto beginX = chunkX * kChunkSize;
+		const auto beginY = chunkY * kChunkSize;
+		const auto endX = std::min(beginX + kChunkSize, mNumTiles.x);
+		const auto endY = std::min(beginY + kChunkSize, mNumTiles.y);
+
+		auto& chunkTiles = mChunkTiles;
+		chunkTiles.clear();
+
+		for (uint32_t y = beginY; y < endY; y++)
+		{
+			for (uint32_t x = beginX; x < endX; x++)
 			{
-				auto tileId = tileData[idx];
+				const auto idx = y * mNumTiles.x + x;
+				const auto tileId = tileLayer.getTile(idx);
+
 				if (tileId == 0)
 				{
 					continue;
 				}
 
-				auto* tileSet = getTileSetFromId(tileId);
-				if (tileSet != nullptr)
+				if (auto* tileInfo = getTileInfo(tileId); tileInfo != nullptr &&
+					tileInfo->tileSet->getTexture() != nullptr)
 				{
-					auto srcPosition = tileSet->getPosition(tileId);
-					const auto& srcSize = tileSet->getTileSize();
+					chunkTiles.push_back(std::make_pair(tileInfo->tileSet->getTexture(), idx));
+				}
+			}
+		}
 
-					auto dstPosition = position + glm::vec2{
-						(float)(idx % mNumTiles.x) * mTileSize.x,
-						(float)(idx / mNumTiles.x) * mTileSize.y
-					};
+		std::stable_sort(chunkTiles.begin(), chunkTiles.end(), [](const auto& a, const auto& b) {
+			return a.first < b.first;
+		});
 
-					if ((dstPosition.x + mTileSize.x < left || dstPosition.y + mTileSize.y < bottom) ||
-						(dstPosition.x > right || dstPosition.y > top))
-					{
-						continue;
-					}
+		chunk.vertices.resize(chunkTiles.size() * 4);
+		chunk.batches.clear();
+		chunk.dirty = false;
 
-					batchRenderer.drawTexture(tileSet->getTexture(), srcPosition, srcSize,
-						dstPosition, mTileSize);
-				}
+		auto* vertices = chunk.vertices.data();
+		for (uint32_t quad = 0; quad < (uint32_t)chunkTiles.size(); quad++)
+		{
+			auto [texture, idx] = chunkTiles[quad];
+			if (chunk.batches.empty() || chunk.batches.back().texture != texture)
+			{
+				chunk.batches.push_back({
+					.texture = texture,
+					.firstQuad = quad
+				});
+			}
+
+			chunk.batches.back().numQuads++;
+
+			const auto& tileInfo = mTileInfos[tileLayer.getTile(idx)];
+			const auto& srcPosition = tileInfo.srcPosition;
+			const auto& srcSize = tileInfo.tileSet->getTileSize();
+
+			const glm::vec2 invTextureSize{
+				1.0f / (float)texture->getWidth(),
+				1.0f / (float)texture->getHeight()
+			};
+
+			const auto uv1 = srcPosition * invTextureSize;
+			const auto uv2 = (srcPosition + srcSize) * invTextureSize;
+
+			const glm::vec2 p1{
+				(float)(idx % mNumTiles.x) * mTileSize.x,
+				(float)(idx / mNumTiles.x) * mTileSize.y
+			};
+
+			const auto p2 = p1 + mTileSize;
+
+			vertices[0] = { .position = { p1.x, p1.y }, .uv = { uv1.x, uv2.y }, .color = glm::vec4{ 0.0f } };
+			vertices[1] = { .position = { p1.x, p2.y }, .uv = { uv1.x, uv1.y }, .color = glm::vec4{ 0.0f } };
+			vertices[2] = { .position = { p2.x, p2.y }, .uv = { uv2.x, uv1.y }, .color = glm::vec4{ 0.0f } };
+			vertices[3] = { .position = { p2.x, p1.y }, .uv = { uv2.x, uv2.y }, .color = glm::vec4{ 0.0f } };
+			vertices += 4;
+		}
+	}
+
+	void TileMap::drawChunk(BatchRenderer& batchRenderer, const glm::vec2& position, const TileChunk& chunk)
+	{
+		for (const auto& batch : chunk.batches)
+		{
+			auto* vertices = batchRenderer.allocateQuads(batch.texture, batch.numQuads);
+			if (vertices == nullptr)
+			{
+				continue;
+			}
+
+			const auto* src = &chunk.vertices[batch.firstQuad * 4];
+			for (uint32_t idx = 0; idx < batch.numQuads * 4; idx++)
+			{
+				vertices[idx] = src[idx];
+				vertices[idx].position += position;
 			}
 		}
 	}
@@ -292,6 +571,11 @@ namespace Trinity
 				}
 			}
 
+			if (mTileMap->mNumTiles.x > 0 && mTileMap->mNumTiles.y > 0)
+			{
+				tileLayer->resize(mTileMap->mNumTiles.x, mTileMap->mNumTiles.y);
+			}
+
 			mTileMap->mTileLayers.push_back(std::move(tileLayer));
 		}
 
@@ -300,6 +584,7 @@ namespace Trinity
 			mTileMap->mNumTiles.y * mTileMap->mTileSize.y
 		};
 
+		mTileMap->buildTileInfos();
 		return true;
 	}
 
@@ -421,6 +706,11 @@ namespace Trinity
 				}
 			}
 
+			if (mTileMap->mNumTiles.x > 0 && mTileMap->mNumTiles.y > 0)
+			{
+				tileLayer->resize(mTileMap->mNumTiles.x, mTileMap->mNumTiles.y);
+			}
+
 			mTileMap->mTileLayers.push_back(std::move(tileLayer));
 		}
 
@@ -429,6 +719,7 @@ namespace Trinity
 			mTileMap->mNumTiles.y * mTileMap->mTileSize.y
 		};
 
+		mTileMap->buildTileInfos();
 		return true;
 	}
 
@@ -528,6 +819,7 @@ namespace Trinity
 
 	void TileMapEditor::updateTileMapSize()
 	{
+		mTileMap->invalidateChunks();
 		mTileMap->mSize = {
 			mTileMap->mTileSize.x * mTileMap->mNumTiles.x,
 			mTileMap->mTileSize.y * mTileMap->mNumTiles.y
@@ -0,0 +1,452 @@
+#include "TileMap/TileMapStreamer.h"
+#include "TileMap/TileMap.h"
+#include "TileMap/TileLayer.h"
+#include "VFS/FileSystem.h"
+#include "Core/Logger.h"
+#include <algorithm>
+
+namespace Trinity
+{
+	TileMapStreamer::~TileMapStreamer()
+	{
+		destroy();
+	}
+
+	bool TileMapStreamer::create(TileMap& tileMap, const std::string& path)
+	{
+		const auto& numTiles = tileMap.getNumTiles();
+		if (numTiles.x == 0 || numTiles.y == 0)
+		{
+			LogError("TileMapStreamer::create() failed, tile map is empty!!");
+			return false;
+		}
+
+		destroy();
+
+		mTileMap = &tileMap;
+		mPath = path;
+		mNumRegions = {
+			(numTiles.x + kRegionSize - 1) / kRegionSize,
+			(numTiles.y + kRegionSize - 1) / kRegionSize
+		};
+
+		mRegions = std::vector<Region>(mNumRegions.x * mNumRegions.y);
+
+		for (auto* tileLayer : tileMap.getTileLayers())
+		{
+			tileLayer->setData({});
+			tileLayer->setStorage(TileLayerStorage::Sparse);
+			tileLayer->resize(numTiles.x, numTiles.y);
+		}
+
+		return true;
+	}
+
+	void TileMapStreamer::destroy()
+	{
+		for (auto& region : mRegions)
+		{
+			if (region.job != nullptr && JobSystem::hasInstance())
+			{
+				JobSystem::get().wait(region.job);
+			}
+		}
+
+		mRegions.clear();
+		mResident.clear();
+		mMemoryUsage = 0;
+		mTileMap = nullptr;
+	}
+
+	void TileMapStreamer::setLoadRadius(float loadRadius)
+	{
+		mLoadRadius = loadRadius;
+	}
+
+	void TileMapStreamer::setUnloadRadius(float unloadRadius)
+	{
+		mUnloadRadius = unloadRadius;
+	}
+
+	void TileMapStreamer::setMemoryBudget(size_t memoryBudget)
+	{
+		mMemoryBudget = memoryBudget;
+	}
+
+	void TileMapStreamer::update(const glm::vec2& position, const glm::vec2& center)
+	{
+		if (mTileMap == nullptr)
+		{
+			return;
+		}
+
+		const auto localCenter = center - position;
+		const auto unloadRadius = std::max(mUnloadRadius, mLoadRadius);
+
+		for (auto regionIdx : mResident)
+		{
+			auto& region = mRegions[regionIdx];
+			if (region.state == RegionState::Loading && (region.job == nullptr || region.job->finished))
+			{
+				applyRegion(regionIdx);
+			}
+		}
+
+		for (uint32_t idx = 0; idx < (uint32_t)mResident.size();)
+		{
+			auto regionIdx = mResident[idx];
+			if (mRegions[regionIdx].state == RegionState::Loaded && 
+				getRegionDistance(regionIdx, localCenter) > unloadRadius)
+			{
+				unloadRegion(regionIdx);
+				continue;
+			}
+
+			idx++;
+		}
+
+		while (mMemoryUsage > mMemoryBudget)
+		{
+			auto it = std::max_element(mResident.begin(), mResident.end(), [&](auto a, auto b) {
+				const auto loadedA = mRegions[a].state == RegionState::Loaded;
+				const auto loadedB = mRegions[b].state == RegionState::Loaded;
+
+				if (loadedA != loadedB)
+				{
+					return !loadedA;
+				}
+
+				return getRegionDistance(a, localCenter) < getRegionDistance(b, localCenter);
+			});
+
+			if (it == mResident.end() || mRegions[*it].state != RegionState::Loaded)
+			{
+				break;
+			}
+
+			unloadRegion(*it);
+		}
+
+		const auto regionSize = mTileMap->getTileSize() * (float)kRegionSize;
+		if (regionSize.x <= 0.0f || regionSize.y <= 0.0f)
+		{
+			return;
+		}
+
+		const auto minRegion = glm::max(glm::floor((localCenter - mLoadRadius) / regionSize), glm::vec2{ 0.0f });
+		const auto maxRegion = glm::floor((localCenter + mLoadRadius) / regionSize);
+
+		if (maxRegion.x < 0.0f || maxRegion.y < 0.0f)
+		{
+			return;
+		}
+
+		const auto endX = std::min((uint32_t)maxRegion.x + 1, mNumRegions.x);
+		const auto endY = std::min((uint32_t)maxRegion.y + 1, mNumRegions.y);
+
+		std::vector<std::pair<float, uint32_t>> candidates;
+		for (auto y = (uint32_t)minRegion.y; y < endY; y++)
+		{
+			for (auto x = (uint32_t)minRegion.x; x < endX; x++)
+			{
+				const auto regionIdx = y * mNumRegions.x + x;
+				if (mRegions[regionIdx].state != RegionState::Unloaded)
+				{
+					continue;
+				}
+
+				if (auto distance = getRegionDistance(regionIdx, localCenter); distance <= mLoadRadius)
+				{
+					candidates.push_back(std::make_pair(distance, regionIdx));
+				}
+			}
+		}
+
+		std::sort(candidates.begin(), candidates.end());
+
+		for (auto& [distance, regionIdx] : candidates)
+		{
+			if (mMemoryUsage + getRegionMemory(regionIdx) > mMemoryBudget)
+			{
+				break;
+			}
+
+			loadRegion(regionIdx);
+		}
+	}
+
+	bool TileMapStreamer::writeRegions(TileMap& tileMap, const std::string& path)
+	{
+		const auto& numTiles = tileMap.getNumTiles();
+		const auto tileLayers = tileMap.getTileLayers();
+		const auto numLayers = (uint32_t)tileLayers.size();
+
+		const glm::uvec2 numRegions{
+			(numTiles.x + kRegionSize - 1) / kRegionSize,
+			(numTiles.y + kRegionSize - 1) / kRegionSize
+		};
+
+		TileLayerSerializer serializer;
+		std::vector<std::vector<uint32_t>> layers(numLayers);
+
+		for (uint32_t regionY = 0; regionY < numRegions.y; regionY++)
+		{
+			for (uint32_t regionX = 0; regionX < numRegions.x; regionX++)
+			{
+				const auto beginX = regionX * kRegionSize;
+				const auto beginY = regionY * kRegionSize;
+				const auto endX = std::min(beginX + kRegionSize, numTiles.x);
+				const auto endY = std::min(beginY + kRegionSize, numTiles.y);
+
+				bool isEmpty{ true };
+				for (uint32_t layerIdx = 0; layerIdx < numLayers; layerIdx++)
+				{
+					auto& tiles = layers[layerIdx];
+					tiles.clear();
+
+					for (auto y = beginY; y < endY; y++)
+					{
+						for (auto x = beginX; x < endX; x++)
+						{
+							const auto tileId = tileLayers[layerIdx]->getTile(y * numTiles.x + x);
+							isEmpty = isEmpty && tileId == 0;
+							tiles.push_back(tileId);
+						}
+					}
+				}
+
+				if (isEmpty)
+				{
+					continue;
+				}
+
+				const auto regionPath = getRegionPath(path, regionX, regionY);
+				auto file = FileSystem::get().openFile(regionPath, FileOpenMode::OpenWrite);
+
+				if (!file)
+				{
+					LogError("Error opening region file: %s", regionPath.c_str());
+					return false;
+				}
+
+				FileWriter writer{ *file };
+				if (!writer.write(&numLayers))
+				{
+					LogError("FileWriter::write() failed for 'num layers'");
+					return false;
+				}
+
+				for (auto& tiles : layers)
+				{
+					if (!writer.writeVector(serializer.encodeRuns(tiles)))
+					{
+						LogError("FileWriter::writeVector() failed for 'layer runs'");
+						return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	size_t TileMapStreamer::getRegionMemory(uint32_t regionIdx) const
+	{
+		return getLayerMemory(regionIdx) * mTileMap->getNumTileLayers();
+	}
+
+	size_t TileMapStreamer::getLayerMemory(uint32_t regionIdx) const
+	{
+		const auto& numTiles = mTileMap->getNumTiles();
+		const auto beginX = (regionIdx % mNumRegions.x) * kRegionSize;
+		const auto beginY = (regionIdx / mNumRegions.x) * kRegionSize;
+		const auto endX = std::min(beginX + kRegionSize, numTiles.x);
+		const auto endY = std::min(beginY + kRegionSize, numTiles.y);
+
+		const auto chunkSize = TileLayer::kSparseChunkSize;
+		const auto numChunksX = (endX - 1) / chunkSize - beginX / chunkSize + 1;
+		const auto numChunksY = (endY - 1) / chunkSize - beginY / chunkSize + 1;
+
+		return (size_t)numChunksX * numChunksY * chunkSize * chunkSize * sizeof(uint32_t);
+	}
+
+	float TileMapStreamer::getRegionDistance(uint32_t regionIdx, const glm::vec2& center) const
+	{
+		const auto regionSize = mTileMap->getTileSize() * (float)kRegionSize;
+		const glm::vec2 regionMin{
+			(float)(regionIdx % mNumRegions.x) * regionSize.x,
+			(float)(regionIdx / mNumRegions.x) * regionSize.y
+		};
+
+		const auto closest = glm::clamp(center, regionMin, regionMin + regionSize);
+		return glm::length(center - closest);
+	}
+
+	void TileMapStreamer::loadRegion(uint32_t regionIdx)
+	{
+		auto& region = mRegions[regionIdx];
+		const auto& numTiles = mTileMap->getNumTiles();
+		const auto regionX = regionIdx % mNumRegions.x;
+		const auto regionY = regionIdx / mNumRegions.x;
+
+		const auto width = std::min(kRegionSize, numTiles.x - regionX * kRegionSize);
+		const auto height = std::min(kRegionSize, numTiles.y - regionY * kRegionSize);
+		const auto regionPath = getRegionPath(mPath, regionX, regionY);
+
+		region.state = RegionState::Loading;
+		region.failed = false;
+		region.memory = getRegionMemory(regionIdx);
+		mResident.push_back(regionIdx);
+		mMemoryUsage += region.memory;
+
+		if (JobSystem::hasInstance())
+		{
+			region.job = JobSystem::get().schedule([regionPath, numRegionTiles = width * height, &region]() {
+				readRegion(regionPath, numRegionTiles, region);
+			});
+		}
+		else
+		{
+			readRegion(regionPath, width * height, region);
+		}
+	}
+
+	void TileMapStreamer::applyRegion(uint32_t regionIdx)
+	{
+		auto& region = mRegions[regionIdx];
+		region.job = nullptr;
+		region.state = RegionState::Loaded;
+
+		if (region.failed)
+		{
+			const auto& numRegions = mNumRegions;
+			LogError("TileMapStreamer::readRegion() failed for region: %d, %d", 
+				regionIdx % numRegions.x, regionIdx / numRegions.x);
+		}
+		else
+		{
+			writeTiles(regionIdx, &region.layers);
+		}
+
+		const auto numLayers = (size_t)std::count_if(region.layers.begin(), region.layers.end(), [](const auto& tiles) {
+			return std::any_of(tiles.begin(), tiles.end(), [](auto tileId) { return tileId != 0; });
+		});
+
+		mMemoryUsage -= std::min(mMemoryUsage, region.memory);
+		region.memory = getLayerMemory(regionIdx) * std::min(numLayers, (size_t)mTileMap->getNumTileLayers());
+		mMemoryUsage += region.memory;
+
+		std::vector<std::vector<uint32_t>>().swap(region.layers);
+	}
+
+	void TileMapStreamer::unloadRegion(uint32_t regionIdx)
+	{
+		auto& region = mRegions[regionIdx];
+		if (region.state == RegionState::Loading)
+		{
+			if (region.job != nullptr)
+			{
+				JobSystem::get().wait(region.job);
+			}
+
+			applyRegion(regionIdx);
+		}
+
+		writeTiles(regionIdx, nullptr);
+		region.state = RegionState::Unloaded;
+		mMemoryUsage -= std::min(mMemoryUsage, region.memory);
+		region.memory = 0;
+
+		if (auto it = std::find(mResident.begin(), mResident.end(), regionIdx); it != mResident.end())
+		{
+			*it = mResident.back();
+			mResident.pop_back();
+		}
+	}
+
+	void TileMapStreamer::writeTiles(uint32_t regionIdx, const std::vector<std::vector<uint32_t>>* layers)
+	{
+		const auto& numTiles = mTileMap->getNumTiles();
+		const auto numLayers = mTileMap->getNumTileLayers();
+		const auto beginX = (regionIdx % mNumRegions.x) * kRegionSize;
+		const auto beginY = (regionIdx / mNumRegions.x) * kRegionSize;
+		const auto endX = std::min(beginX + kRegionSize, numTiles.x);
+		const auto endY = std::min(beginY + kRegionSize, numTiles.y);
+
+		for (uint32_t layerIdx = 0; layerIdx < numLayers; layerIdx++)
+		{
+			const std::vector<uint32_t>* tiles{ nullptr };
+			if (layers != nullptr)
+			{
+				if (layerIdx >= (uint32_t)layers->size())
+				{
+					break;
+				}
+
+				tiles = &(*layers)[layerIdx];
+			}
+
+			uint32_t localIdx{ 0 };
+			for (auto y = beginY; y < endY; y++)
+			{
+				for (auto x = beginX; x < endX; x++, localIdx++)
+				{
+					const auto tileId = tiles != nullptr ? (*tiles)[localIdx] : 0;
+					if (tileId != mTileMap->getTile(layerIdx, x, y))
+					{
+						mTileMap->setTile(layerIdx, x, y, tileId);
+					}
+				}
+			}
+		}
+	}
+
+	std::string TileMapStreamer::getRegionPath(const std::string& path, uint32_t x, uint32_t y)
+	{
+		return path + "." + std::to_string(x) + "_" + std::to_string(y) + kRegionExtension;
+	}
+
+	bool TileMapStreamer::readRegion(const std::string& path, uint32_t numTiles, Region& region)
+	{
+		region.layers.clear();
+
+		auto& fileSystem = FileSystem::get();
+		if (!fileSystem.isExist(path))
+		{
+			return true;
+		}
+
+		auto file = fileSystem.openFile(path, FileOpenMode::OpenRead);
+		if (!file)
+		{
+			region.failed = true;
+			return false;
+		}
+
+		FileReader reader{ *file };
+		uint32_t numLayers{ 0 };
+
+		if (!reader.read(&numLayers))
+		{
+			region.failed = true;
+			return false;
+		}
+
+		TileLayerSerializer serializer;
+		std::vector<uint32_t> runs;
+		region.layers.resize(numLayers);
+
+		for (auto& tiles : region.layers)
+		{
+			if (!reader.readVector(runs) || !serializer.decodeRuns(runs, tiles) || 
+				(uint32_t)tiles.size() != numTiles)
+			{
+				region.layers.clear();
+				region.failed = true;
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -48,31 +48,37 @@ namespace Trinity
 	void TileSet::setSize(const glm::vec2& size)
 	{
 		mSize = size;
+		mVersion++;
 	}
 
 	void TileSet::setTileSize(const glm::vec2& tileSize)
 	{
 		mTileSize = tileSize;
+		mVersion++;
 	}
 
 	void TileSet::setNumTiles(const glm::uvec2& numTiles)
 	{
 		mNumTiles = numTiles;
+		mVersion++;
 	}
 
 	void TileSet::setSpacing(float spacing)
 	{
 		mSpacing = spacing;
+		mVersion++;
 	}
 
 	void TileSet::setFirstId(uint32_t id)
 	{
 		mFirstId = id;
+		mVersion++;
 	}
 
 	void TileSet::setTexture(Texture* texture)
 	{
 		mTexture = texture;
+		mVersion++;
 	}
 
 	void TileSet::addProperty(uint32_t id, const std::string& name, const std::string& value)
@@ -146,9 +152,21 @@ namespace Trinity
 		if (layout.beginLayout("Tile Set"))
 		{
 			layout.inputString("Name", mTileSet->mName);			
-			layout.inputVec2("Tile Size", mTileSet->mTileSize);
-			layout.inputSize("No. of Tiles", mTileSet->mNumTiles);
-			layout.inputFloat("Spacing", mTileSet->mSpacing);
+
+			if (layout.inputVec2("Tile Size", mTileSet->mTileSize))
+			{
+				mTileSet->mVersion++;
+			}
+
+			if (layout.inputSize("No. of Tiles", mTileSet->mNumTiles))
+			{
+				mTileSet->mVersion++;
+			}
+
+			if (layout.inputFloat("Spacing", mTileSet->mSpacing))
+			{
+				mTileSet->mVersion++;
+			}
 
 			if (layout.fileCombo("Texture", FileType::Texture, mSelectedTextureFile))
 			{
@@ -172,6 +190,8 @@ namespace Trinity
 						(float)mTileSet->mTexture->getWidth(),
 						(float)mTileSet->mTexture->getHeight()
 					};
+
+					mTileSet->mVersion++;
 				}
 			}
 
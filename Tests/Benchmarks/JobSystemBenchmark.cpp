@@ -0,0 +1,67 @@
+#include "Benchmark.h"
+#include "Core/JobSystem.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace Trinity;
+
+static constexpr uint32_t kNumElements = 1 << 20;
+static constexpr uint32_t kGrainSize = 4096;
+static constexpr uint32_t kNumRuns = 5;
+
+int main(int argc, char** argv)
+{
+	auto maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	if (argc > 1)
+	{
+		maxThreads = std::max((uint32_t)std::atoi(argv[1]), 1u);
+	}
+
+	std::vector<float> input(kNumElements);
+	std::vector<float> output(kNumElements);
+
+	for (uint32_t idx = 0; idx < kNumElements; idx++)
+	{
+		input[idx] = (float)idx * 0.001f;
+	}
+
+	auto kernel = [&](uint32_t begin, uint32_t end) {
+		for (auto idx = begin; idx < end; idx++)
+		{
+			auto value = input[idx];
+			for (uint32_t iteration = 0; iteration < 16; iteration++)
+			{
+				value = std::sin(value) * 0.5f + std::sqrt(value * value + 1.0f);
+			}
+
+			output[idx] = value;
+		}
+	};
+
+	std::printf("parallelFor over %u elements, grain size %u, best of %u runs\n", kNumElements, kGrainSize, kNumRuns);
+	std::printf("%8s %12s %10s %12s\n", "threads", "time (ms)", "speedup", "efficiency");
+
+	double baseline{ 0.0 };
+	for (uint32_t numThreads = 1; numThreads <= maxThreads; numThreads++)
+	{
+		JobSystem jobSystem;
+		jobSystem.create(numThreads - 1);
+
+		const auto time = measureBest(kNumRuns, [&]() {
+			jobSystem.parallelFor(kNumElements, kGrainSize, kernel);
+		});
+
+		if (numThreads == 1)
+		{
+			baseline = time;
+		}
+
+		const auto speedup = baseline / time;
+		std::printf("%8u %12.3f %9.2fx %11.1f%%\n", numThreads, time, speedup, speedup / numThreads * 100.0);
+	}
+
+	return 0;
+}
\ No newline at end of file
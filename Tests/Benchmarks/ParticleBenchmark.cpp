@@ -0,0 +1,105 @@
+#include "Benchmark.h"
+#include "Particle/ParticlePool.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtx/euler_angles.hpp"
+
+using namespace Trinity;
+
+static constexpr uint32_t kNumRuns = 10;
+
+class BenchmarkPool : public ParticlePool
+{
+public:
+
+	void writeAll(const glm::mat4& rootTransform, BatchRenderer::Vertex* vertices)
+	{
+		writeVertices(0, mNumActive, mTextureFrames[0], rootTransform, vertices);
+	}
+
+	void writeAllWithMatrices(const glm::mat4& rootTransform, BatchRenderer::Vertex* vertices)
+	{
+		for (uint32_t idx = 0; idx < mNumActive; idx++)
+		{
+			const auto size = mSizes[idx];
+			const auto transform = rootTransform *
+				glm::translate(glm::mat4(1.0f), glm::vec3(mPositions[idx], 0.0f)) *
+				glm::yawPitchRoll(0.0f, 0.0f, mRotations[idx]);
+
+			const auto x1 = -0.5f * size;
+			const auto y1 = -0.5f * size;
+			const auto x2 = x1 + size;
+			const auto y2 = y1 + size;
+
+			const auto p1 = transform * glm::vec4{ x1, y1, 0.0f, 1.0f };
+			const auto p2 = transform * glm::vec4{ x1, y2, 0.0f, 1.0f };
+			const auto p3 = transform * glm::vec4{ x2, y2, 0.0f, 1.0f };
+			const auto p4 = transform * glm::vec4{ x2, y1, 0.0f, 1.0f };
+			const auto& color = mColors[idx];
+
+			vertices[0] = { .position = glm::vec2(p1), .uv = { 0.0f, 0.0f }, .color = color };
+			vertices[1] = { .position = glm::vec2(p2), .uv = { 0.0f, 0.0f }, .color = color };
+			vertices[2] = { .position = glm::vec2(p3), .uv = { 0.0f, 0.0f }, .color = color };
+			vertices[3] = { .position = glm::vec2(p4), .uv = { 0.0f, 0.0f }, .color = color };
+			vertices += 4;
+		}
+	}
+};
+
+static void emitParticles(BenchmarkPool& pool, uint32_t numParticles)
+{
+	std::mt19937 generator(1234);
+	std::uniform_real_distribution<float> position(-512.0f, 512.0f);
+	std::uniform_real_distribution<float> rotation(0.0f, 6.28f);
+
+	pool.init(numParticles);
+	for (uint32_t idx = 0; idx < numParticles; idx++)
+	{
+		pool.emit({
+			.position = { position(generator), position(generator) },
+			.startColor = glm::vec4{ 1.0f },
+			.finalColor = glm::vec4{ 0.0f },
+			.startSize = 8.0f,
+			.finalSize = 2.0f,
+			.startRotation = rotation(generator),
+			.finalRotation = rotation(generator),
+			.drag = 1.0f,
+			.lifeSpan = 10.0f
+		});
+	}
+}
+
+int main()
+{
+	const auto rootTransform = glm::translate(glm::mat4(1.0f), glm::vec3(640.0f, 360.0f, 0.0f)) *
+		glm::yawPitchRoll(0.0f, 0.0f, 0.3f);
+
+	std::printf("Particle vertex generation, best of %u runs\n", kNumRuns);
+	std::printf("%10s %16s %18s %16s %18s\n", "particles", "matrix (ms)", "matrix (Mvert/s)", "axes (ms)", "axes (Mvert/s)");
+
+	for (uint32_t numParticles : { 1000u, 10000u, 100000u, 1000000u })
+	{
+		BenchmarkPool pool;
+		emitParticles(pool, numParticles);
+		pool.update(16.0f);
+
+		std::vector<BatchRenderer::Vertex> vertices(numParticles * 4);
+
+		const auto matrixTime = measureBest(kNumRuns, [&]() {
+			pool.writeAllWithMatrices(rootTransform, vertices.data());
+		});
+
+		const auto axesTime = measureBest(kNumRuns, [&]() {
+			pool.writeAll(rootTransform, vertices.data());
+		});
+
+		const auto numVertices = (double)numParticles * 4.0;
+		std::printf("%10u %16.3f %18.1f %16.3f %18.1f\n", numParticles,
+			matrixTime, numVertices / matrixTime / 1000.0,
+			axesTime, numVertices / axesTime / 1000.0);
+	}
+
+	return 0;
+}
\ No newline at end of file
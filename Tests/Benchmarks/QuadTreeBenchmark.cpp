@@ -0,0 +1,111 @@
+#include "Benchmark.h"
+#include "Scene/QuadTree.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Trinity;
+
+static constexpr float kWorldSize = 8192.0f;
+static constexpr float kMinNodeSize = 64.0f;
+static constexpr float kColliderSize = 8.0f;
+static constexpr uint32_t kNumFrames = 30;
+
+struct Body
+{
+	QuadTreeData data;
+	glm::vec2 position{ 0.0f };
+	glm::vec2 velocity{ 0.0f };
+};
+
+static void moveBodies(std::vector<Body>& bodies)
+{
+	for (auto& body : bodies)
+	{
+		body.position += body.velocity;
+
+		if (body.position.x < 0.0f || body.position.x > kWorldSize - kColliderSize)
+		{
+			body.velocity.x = -body.velocity.x;
+		}
+
+		if (body.position.y < 0.0f || body.position.y > kWorldSize - kColliderSize)
+		{
+			body.velocity.y = -body.velocity.y;
+		}
+
+		body.data.bounds = { body.position, body.position + glm::vec2{ kColliderSize } };
+	}
+}
+
+static std::vector<Body> createBodies(uint32_t numBodies, QuadTree& quadTree)
+{
+	std::mt19937 generator(1234);
+	std::uniform_real_distribution<float> position(0.0f, kWorldSize - kColliderSize);
+	std::uniform_real_distribution<float> velocity(-2.0f, 2.0f);
+
+	std::vector<Body> bodies(numBodies);
+	for (auto& body : bodies)
+	{
+		body.position = { position(generator), position(generator) };
+		body.velocity = { velocity(generator), velocity(generator) };
+		body.data.bounds = { body.position, body.position + glm::vec2{ kColliderSize } };
+
+		quadTree.insert(body.data);
+	}
+
+	return bodies;
+}
+
+int main()
+{
+	const BoundingRect worldBounds{ glm::vec2{ 0.0f }, glm::vec2{ kWorldSize } };
+	const BoundingRect minBounds{ glm::vec2{ 0.0f }, glm::vec2{ kMinNodeSize } };
+
+	std::printf("QuadTree cost per frame, average of %u frames\n", kNumFrames);
+	std::printf("%10s %16s %20s %14s\n", "colliders", "update (ms)", "remove+insert (ms)", "query (ms)");
+
+	for (uint32_t numBodies : { 1000u, 10000u, 100000u })
+	{
+		QuadTree quadTree;
+		quadTree.create(minBounds, worldBounds);
+
+		auto bodies = createBodies(numBodies, quadTree);
+		std::vector<QuadTreeData*> result;
+
+		double updateTime{ 0.0 };
+		double reinsertTime{ 0.0 };
+		double queryTime{ 0.0 };
+
+		for (uint32_t frame = 0; frame < kNumFrames; frame++)
+		{
+			moveBodies(bodies);
+			updateTime += measureBest(1, [&]() {
+				for (auto& body : bodies)
+				{
+					quadTree.update(body.data);
+				}
+			});
+
+			moveBodies(bodies);
+			reinsertTime += measureBest(1, [&]() {
+				for (auto& body : bodies)
+				{
+					quadTree.insert(body.data);
+				}
+			});
+
+			queryTime += measureBest(1, [&]() {
+				for (auto& body : bodies)
+				{
+					quadTree.query(body.data.bounds, result);
+				}
+			});
+		}
+
+		std::printf("%10u %16.3f %20.3f %14.3f\n", numBodies, updateTime / kNumFrames,
+			reinsertTime / kNumFrames, queryTime / kNumFrames);
+	}
+
+	return 0;
+}
\ No newline at end of file
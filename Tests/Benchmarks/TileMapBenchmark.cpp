@@ -0,0 +1,134 @@
+#include "Benchmark.h"
+#include "TileMap/TileMap.h"
+#include "TileMap/TileSet.h"
+#include "TileMap/TileLayer.h"
+#include "Graphics/Texture.h"
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace Trinity;
+
+static constexpr float kTileSize = 16.0f;
+static constexpr float kViewWidth = 1280.0f;
+static constexpr float kViewHeight = 720.0f;
+static constexpr float kPanSpeed = 4.0f;
+static constexpr uint32_t kNumFrames = 120;
+static constexpr uint32_t kNumLayers = 2;
+
+class StagingRenderer : public BatchRenderer
+{
+public:
+
+	virtual Vertex* allocateQuads(Texture* texture, uint32_t numQuads) override
+	{
+		if (mNumVertices + numQuads * 4 > (uint32_t)mVertices.size())
+		{
+			mVertices.resize(mNumVertices + numQuads * 4);
+		}
+
+		auto* vertices = &mVertices[mNumVertices];
+		mNumVertices += numQuads * 4;
+
+		return vertices;
+	}
+
+	uint32_t getNumVertices() const
+	{
+		return mNumVertices;
+	}
+
+	void reset()
+	{
+		mNumVertices = 0;
+	}
+
+protected:
+
+	std::vector<Vertex> mVertices;
+	uint32_t mNumVertices{ 0 };
+};
+
+static std::unique_ptr<TileMap> createTileMap(uint32_t numTiles, Texture& texture)
+{
+	auto tileSet = std::make_unique<TileSet>();
+	tileSet->setTileSize({ kTileSize, kTileSize });
+	tileSet->setNumTiles({ 16, 16 });
+	tileSet->setFirstId(1);
+	tileSet->setTexture(&texture);
+
+	auto tileMap = std::make_unique<TileMap>();
+	tileMap->setTileSize({ kTileSize, kTileSize });
+	tileMap->setNumTiles({ numTiles, numTiles });
+	tileMap->setSize({ numTiles * kTileSize, numTiles * kTileSize });
+	tileMap->addTileSet(std::move(tileSet));
+
+	std::mt19937 generator(1234);
+	std::uniform_int_distribution<uint32_t> tileId(0, 256);
+
+	for (uint32_t layerIdx = 0; layerIdx < kNumLayers; layerIdx++)
+	{
+		std::vector<uint32_t> data((size_t)numTiles * numTiles);
+		for (auto& tile : data)
+		{
+			tile = tileId(generator);
+		}
+
+		auto tileLayer = std::make_unique<TileLayer>();
+		tileLayer->setData(std::move(data));
+		tileMap->addTileLayer(std::move(tileLayer));
+	}
+
+	return tileMap;
+}
+
+int main()
+{
+	Texture texture;
+
+	std::printf("TileMap::draw cost for a %.0fx%.0f view, %u layers, average of %u frames\n",
+		kViewWidth, kViewHeight, kNumLayers, kNumFrames);
+	std::printf("%12s %16s %16s %16s %12s\n", "map (tiles)", "first (ms)", "static (ms)", "panning (ms)", "quads");
+
+	for (uint32_t numTiles : { 64u, 256u, 1024u, 4096u })
+	{
+		auto tileMap = createTileMap(numTiles, texture);
+		StagingRenderer renderer;
+
+		const glm::vec2 origin{ 0.0f };
+		const auto mapSize = (float)numTiles * kTileSize;
+
+		auto drawAt = [&](float x, float y) {
+			renderer.reset();
+			tileMap->draw(renderer, origin, x, y, x + kViewWidth, y + kViewHeight);
+		};
+
+		const auto firstTime = measureBest(1, [&]() {
+			drawAt(0.0f, 0.0f);
+		});
+
+		const auto numQuads = renderer.getNumVertices() / 4;
+
+		const auto staticTime = measureBest(1, [&]() {
+			for (uint32_t frame = 0; frame < kNumFrames; frame++)
+			{
+				drawAt(0.0f, 0.0f);
+			}
+		});
+
+		const auto panningTime = measureBest(1, [&]() {
+			for (uint32_t frame = 0; frame < kNumFrames; frame++)
+			{
+				const auto x = std::min((float)frame * kPanSpeed, std::max(mapSize - kViewWidth, 0.0f));
+				const auto y = std::min((float)frame * kPanSpeed, std::max(mapSize - kViewHeight, 0.0f));
+				drawAt(x, y);
+			}
+		});
+
+		std::printf("%7ux%-4u %16.3f %16.3f %16.3f %12u\n", numTiles, numTiles, firstTime,
+			staticTime / kNumFrames, panningTime / kNumFrames, numQuads);
+	}
+
+	return 0;
+}
\ No newline at end of file
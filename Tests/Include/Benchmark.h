@@ -0,0 +1,25 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace Trinity
+{
+	inline double measureBest(uint32_t numRuns, const std::function<void()>& func)
+	{
+		auto best = std::numeric_limits<double>::max();
+		for (uint32_t run = 0; run < numRuns; run++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const auto end = std::chrono::steady_clock::now();
+
+			best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+		}
+
+		return best;
+	}
+}
\ No newline at end of file
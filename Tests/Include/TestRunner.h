@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Trinity
+{
+	struct TestCase
+	{
+		std::string name;
+		std::function<bool()> run;
+	};
+
+	inline bool expect(bool condition, const char* message)
+	{
+		if (!condition)
+		{
+			std::printf("    expectation failed: %s\n", message);
+		}
+
+		return condition;
+	}
+
+	inline int runTests(const std::vector<TestCase>& tests)
+	{
+		uint32_t numPassed{ 0 };
+		for (auto& test : tests)
+		{
+			const auto passed = test.run();
+			if (passed)
+			{
+				numPassed++;
+			}
+
+			std::printf("[%s] %s\n", passed ? "PASS" : "FAIL", test.name.c_str());
+		}
+
+		std::printf("%u/%u tests passed\n", numPassed, (uint32_t)tests.size());
+		return numPassed == (uint32_t)tests.size() ? 0 : 1;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "TestRunner.h"
+#include "Graphics/BatchRenderer.h"
+#include "Graphics/GraphicsDevice.h"
+#include "Graphics/FrameBuffer.h"
+#include "Graphics/RenderPass.h"
+#include "Graphics/Texture.h"
+#include "VFS/FileSystem.h"
+#include "Core/ResourceCache.h"
+#include "Core/Logger.h"
+#include "Core/Debugger.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Trinity;
+
+static constexpr const char* kTexturedShader = "/Assets/Engine/Shaders/Textured.wgsl";
+static constexpr const char* kColoredShader = "/Assets/Engine/Shaders/Colored.wgsl";
+static constexpr uint32_t kTextureSize = 4;
+static constexpr uint32_t kNumTextures = BatchRenderer::kMaxTextureSlots + 2;
+static constexpr auto kTimeout = std::chrono::seconds(10);
+
+static bool waitFor(const std::function<bool()>& condition)
+{
+	const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+	while (!condition())
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+
+		GraphicsDevice::get().poll();
+		std::this_thread::yield();
+	}
+
+	return true;
+}
+
+static bool isValid(const std::function<bool()>& func)
+{
+	struct ErrorScope
+	{
+		bool popped{ false };
+		bool valid{ true };
+	};
+
+	auto& device = GraphicsDevice::get().getDevice();
+	device.PushErrorScope(wgpu::ErrorFilter::Validation);
+
+	const auto result = func();
+
+	ErrorScope errorScope;
+	device.PopErrorScope(
+		[](WGPUErrorType type, char const* message, void* userdata) {
+			auto* errorScope = reinterpret_cast<ErrorScope*>(userdata);
+			errorScope->valid = type == WGPUErrorType_NoError;
+			errorScope->popped = true;
+		},
+	&errorScope);
+
+	return result && waitFor([&]() { return errorScope.popped; }) && errorScope.valid;
+}
+
+static bool createDevice(GraphicsDevice& graphicsDevice)
+{
+	bool created{ false };
+	graphicsDevice.onCreated.subscribe([&](bool result) {
+		created = result;
+	});
+
+	graphicsDevice.createHeadless(wgpu::BackendType::Null);
+	return created;
+}
+
+static bool createFrameBuffer(FrameBuffer& frameBuffer)
+{
+	return frameBuffer.create(64, 64) &&
+		frameBuffer.addColorAttachment(wgpu::TextureFormat::BGRA8Unorm, wgpu::TextureUsage::RenderAttachment);
+}
+
+static bool drawFrame(BatchRenderer& renderer, FrameBuffer& frameBuffer, const std::vector<Texture*>& textures)
+{
+	RenderPass renderPass;
+	if (!renderPass.begin(frameBuffer))
+	{
+		return false;
+	}
+
+	renderer.begin(glm::mat4{ 1.0f });
+
+	bool result = renderer.drawRect(glm::vec2{ 0.0f }, glm::vec2{ 16.0f }, glm::vec4{ 1.0f });
+	for (uint32_t idx = 0; idx < (uint32_t)textures.size(); idx++)
+	{
+		const glm::vec2 position{ 4.0f * (float)idx, 0.0f };
+		result &= renderer.drawTexture(textures[idx], glm::vec2{ 0.0f }, glm::vec2{ (float)kTextureSize }, 
+			position, glm::vec2{ 8.0f }, glm::vec4{ 1.0f });
+	}
+
+	renderer.end(renderPass);
+	renderPass.end();
+
+	return result;
+}
+
+static bool testCreatePipelines()
+{
+	GraphicsDevice graphicsDevice;
+	if (!createDevice(graphicsDevice))
+	{
+		std::printf("    null adapter not available, skipped\n");
+		return true;
+	}
+
+	ResourceCache cache;
+	FrameBuffer frameBuffer;
+	std::vector<Texture> textures(kNumTextures);
+	std::vector<Texture*> texturePtrs;
+
+	bool passed{ true };
+	passed &= expect(createFrameBuffer(frameBuffer), "an offscreen frame buffer is created on the null adapter");
+
+	for (auto& texture : textures)
+	{
+		passed &= expect(texture.create(kTextureSize, kTextureSize, wgpu::TextureFormat::RGBA8Unorm, 
+			wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst), "a texture is created on the null adapter");
+
+		texturePtrs.push_back(&texture);
+	}
+
+	if (!passed)
+	{
+		return false;
+	}
+
+	const std::vector<BatchVertexFormat> vertexFormats = {
+		BatchVertexFormat::Standard,
+		BatchVertexFormat::Packed,
+		BatchVertexFormat::Instanced
+	};
+
+	const std::vector<BatchTextureMode> textureModes = {
+		BatchTextureMode::Single,
+		BatchTextureMode::Array
+	};
+
+	for (auto vertexFormat : vertexFormats)
+	{
+		for (auto textureMode : textureModes)
+		{
+			BatchRenderer renderer;
+			renderer.setVertexFormat(vertexFormat);
+			renderer.setTextureMode(textureMode);
+
+			const auto created = isValid([&]() {
+				return renderer.create(frameBuffer, cache, kTexturedShader, kColoredShader);
+			});
+
+			passed &= expect(created, "the batch pipelines validate");
+			passed &= expect(created && isValid([&]() { return drawFrame(renderer, frameBuffer, texturePtrs); }), 
+				"a frame spanning several texture sets draws without validation errors");
+			passed &= expect(!renderer.setVertexFormat(BatchVertexFormat::Standard) || vertexFormat == BatchVertexFormat::Standard, 
+				"the vertex format is fixed after create()");
+			passed &= expect(!renderer.setTextureMode(BatchTextureMode::Single) || textureMode == BatchTextureMode::Single, 
+				"the texture mode is fixed after create()");
+
+			if (!passed)
+			{
+				std::printf("    failed for vertex format %u, texture mode %u\n", (uint32_t)vertexFormat, (uint32_t)textureMode);
+				return false;
+			}
+		}
+	}
+
+	return passed;
+}
+
+int main()
+{
+	Logger logger;
+	Debugger debugger;
+	FileSystem fileSystem;
+
+	if (!fileSystem.addFolder("/Assets", "Assets"))
+	{
+		std::printf("Assets folder not found, run from the repository root\n");
+		return 1;
+	}
+
+	return runTests({
+		{ "BatchRenderer pipelines validate for every vertex format and texture mode", testCreatePipelines }
+	});
+}
\ No newline at end of file
@@ -0,0 +1,438 @@
+#include "TestRunner.h"
+#include "Graphics/BatchRenderer.h"
+#include "Graphics/Texture.h"
+#include "Core/Logger.h"
+#include "glm/gtc/packing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Trinity;
+
+class TestBatchRenderer : public BatchRenderer
+{
+public:
+
+	TestBatchRenderer()
+	{
+		setTextureMode(BatchTextureMode::Array);
+		setSortMode(BatchSortMode::Texture);
+	}
+
+	void drawQuad(Texture* texture, uint32_t quadId)
+	{
+		writeQuad(allocateQuads(texture, 1), quadId);
+	}
+
+	void drawShardQuad(uint32_t shardIndex, Texture* texture, uint32_t quadId)
+	{
+		writeQuad(allocateShardQuads(shardIndex, texture, 1), quadId);
+	}
+
+	void drawQuad(const Vertex* vertices)
+	{
+		std::copy(vertices, vertices + 4, allocateQuads(nullptr, 1));
+	}
+
+	const std::vector<PackedVertex>& getPackedVertices()
+	{
+		packVertices(mStagingContext.numVertices);
+		return mStagingContext.packedVertices;
+	}
+
+	const std::vector<QuadInstance>& getInstances()
+	{
+		packInstances(mStagingContext.numVertices);
+		return mStagingContext.instances;
+	}
+
+	const std::vector<Vertex>& getVertices() const
+	{
+		return mStagingContext.vertices;
+	}
+
+	void sort()
+	{
+		if (mNumShards > 0)
+		{
+			mergeShards();
+		}
+
+		sortCommands();
+	}
+
+	const std::vector<DrawCommand>& getCommands() const
+	{
+		return mCommands;
+	}
+
+	std::vector<uint32_t> getQuadOrder() const
+	{
+		std::vector<uint32_t> quadIds;
+		for (uint32_t idx = 0; idx < mStagingContext.numVertices; idx += 4)
+		{
+			quadIds.push_back((uint32_t)mStagingContext.vertices[idx].position.x);
+		}
+
+		return quadIds;
+	}
+
+	bool hasIntactQuads() const
+	{
+		for (uint32_t idx = 0; idx < mStagingContext.numVertices; idx++)
+		{
+			const auto& vertex = mStagingContext.vertices[idx];
+			if (vertex.position.y != (float)(idx % 4) || vertex.uv.x != vertex.position.x)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool hasMatchingCommands(const std::vector<Texture*>& quadTextures) const
+	{
+		uint32_t baseVertex{ 0 };
+		for (auto& command : mCommands)
+		{
+			if (command.customDraw != kInvalidCustomDraw)
+			{
+				continue;
+			}
+
+			if (command.baseVertex != baseVertex)
+			{
+				return false;
+			}
+
+			for (uint32_t quad = 0; quad < command.numQuads; quad++)
+			{
+				const auto quadId = (uint32_t)mStagingContext.vertices[baseVertex + quad * 4].position.x;
+				if (quadTextures[quadId] != command.texture)
+				{
+					return false;
+				}
+			}
+
+			baseVertex += command.numQuads * 4;
+		}
+
+		return baseVertex == mStagingContext.numVertices;
+	}
+
+private:
+
+	void writeQuad(Vertex* vertices, uint32_t quadId)
+	{
+		for (uint32_t corner = 0; corner < 4; corner++)
+		{
+			vertices[corner] = {
+				.position = { (float)quadId, (float)corner },
+				.uv = { (float)quadId, 0.0f },
+				.color = glm::vec4{ 1.0f }
+			};
+		}
+	}
+};
+
+static bool isNear(const glm::vec2& lhs, const glm::vec2& rhs, float tolerance)
+{
+	return std::abs(lhs.x - rhs.x) <= tolerance && std::abs(lhs.y - rhs.y) <= tolerance;
+}
+
+static bool isNear(const glm::vec4& lhs, const glm::vec4& rhs, float tolerance)
+{
+	return isNear(glm::vec2{ lhs.x, lhs.y }, glm::vec2{ rhs.x, rhs.y }, tolerance) && 
+		isNear(glm::vec2{ lhs.z, lhs.w }, glm::vec2{ rhs.z, rhs.w }, tolerance);
+}
+
+static void drawQuads(TestBatchRenderer& renderer, uint32_t numQuads)
+{
+	for (uint32_t quad = 0; quad < numQuads; quad++)
+	{
+		const auto angle = 0.3f * (float)quad;
+		const glm::vec2 position{ 100.0f * (float)quad - 250.0f, 17.5f * (float)quad };
+		const glm::vec2 axisX{ 32.0f * std::cos(angle), 32.0f * std::sin(angle) };
+		const glm::vec2 axisY{ -48.0f * std::sin(angle), 48.0f * std::cos(angle) };
+		const glm::vec2 uvStart{ 0.125f * (float)(quad % 8), 0.25f };
+		const glm::vec2 uvEnd{ uvStart.x + 0.125f, 0.5f };
+		const glm::vec4 color{ 0.1f * (float)quad, 0.5f, 1.0f - 0.1f * (float)quad, 0.75f };
+
+		const BatchRenderer::Vertex vertices[] = {
+			{ .position = position, .uv = uvStart, .color = color },
+			{ .position = position + axisY, .uv = { uvStart.x, uvEnd.y }, .color = color },
+			{ .position = position + axisX + axisY, .uv = uvEnd, .color = color },
+			{ .position = position + axisX, .uv = { uvEnd.x, uvStart.y }, .color = color }
+		};
+
+		renderer.drawQuad(vertices);
+	}
+}
+
+static uint32_t getBatchLayer(uint32_t layer)
+{
+	return std::numeric_limits<uint32_t>::max() - layer;
+}
+
+static bool testSortIsStable()
+{
+	Texture textureA;
+	Texture textureB;
+	TestBatchRenderer renderer;
+
+	const std::vector<Texture*> quadTextures = { &textureA, &textureB, &textureA, &textureB, &textureA };
+	for (uint32_t quadId = 0; quadId < (uint32_t)quadTextures.size(); quadId++)
+	{
+		renderer.drawQuad(quadTextures[quadId], quadId);
+	}
+
+	renderer.sort();
+
+	bool passed{ true };
+	passed &= expect(renderer.getQuadOrder() == std::vector<uint32_t>{ 0, 2, 4, 1, 3 }, 
+		"quads sharing a texture keep their submission order");
+	passed &= expect(renderer.hasIntactQuads(), "every quad keeps its four vertices together");
+
+	return passed;
+}
+
+static bool testSortMergesRuns()
+{
+	Texture textureA;
+	Texture textureB;
+	TestBatchRenderer renderer;
+
+	const std::vector<Texture*> quadTextures = { &textureA, &textureB, &textureA, &textureB, &textureA, nullptr };
+	for (uint32_t quadId = 0; quadId < (uint32_t)quadTextures.size(); quadId++)
+	{
+		renderer.drawQuad(quadTextures[quadId], quadId);
+	}
+
+	renderer.sort();
+
+	const auto& commands = renderer.getCommands();
+
+	bool passed{ true };
+	passed &= expect(commands.size() == 3, "sorting merges commands into one run per texture");
+	passed &= expect(commands.size() == 3 && commands[0].texture == nullptr && commands[0].numQuads == 1, 
+		"untextured quads draw first within a layer");
+	passed &= expect(commands.size() == 3 && commands[1].texture == &textureA && commands[1].numQuads == 3, 
+		"the first texture forms a single run");
+	passed &= expect(commands.size() == 3 && commands[2].texture == &textureB && commands[2].numQuads == 2, 
+		"the second texture forms a single run");
+	passed &= expect(renderer.hasMatchingCommands(quadTextures), "command ranges point at their own quads");
+
+	return passed;
+}
+
+static bool testSortKeepsLayerOrder()
+{
+	Texture textureA;
+	Texture textureB;
+	TestBatchRenderer renderer;
+
+	const std::vector<Texture*> quadTextures = { &textureB, &textureA, &textureA, &textureB, &textureA, &textureB };
+	const std::vector<uint32_t> quadLayers = { 5, 5, 2, 2, 2, 0 };
+
+	renderer.beginShards(2);
+
+	for (uint32_t quadId = 0; quadId < (uint32_t)quadTextures.size(); quadId++)
+	{
+		const auto shardIndex = quadId / 3;
+		renderer.setShardLayer(shardIndex, getBatchLayer(quadLayers[quadId]));
+		renderer.drawShardQuad(shardIndex, quadTextures[quadId], quadId);
+	}
+
+	renderer.sort();
+
+	bool passed{ true };
+	passed &= expect(renderer.getQuadOrder() == std::vector<uint32_t>{ 0, 1, 3, 2, 4, 5 }, 
+		"higher layers draw first and textures sort only within a layer");
+	passed &= expect(renderer.getCommands().size() == 5, "runs do not merge across layers out of order");
+	passed &= expect(renderer.hasIntactQuads(), "every quad keeps its four vertices together");
+	passed &= expect(renderer.hasMatchingCommands(quadTextures), "command ranges point at their own quads");
+
+	return passed;
+}
+
+static bool testSortKeepsCustomDraws()
+{
+	Texture textureA;
+	Texture textureB;
+	TestBatchRenderer renderer;
+
+	const std::vector<Texture*> quadTextures = { &textureA, &textureA, nullptr, &textureB };
+	auto customDraw = [](const RenderPass&, const glm::mat4&) {};
+
+	renderer.setLayer(1);
+	renderer.drawQuad(quadTextures[0], 0);
+	renderer.drawCustom(customDraw);
+	renderer.drawQuad(quadTextures[1], 1);
+
+	renderer.setLayer(0);
+	renderer.drawQuad(quadTextures[2], 2);
+	renderer.drawCustom(customDraw);
+	renderer.drawQuad(quadTextures[3], 3);
+
+	auto isCustomDraw = [&](uint32_t idx, uint32_t customDraw) {
+		const auto& commands = renderer.getCommands();
+		return idx < (uint32_t)commands.size() && commands[idx].customDraw == customDraw && commands[idx].numQuads == 0;
+	};
+
+	bool passed{ true };
+	passed &= expect(renderer.getCommands().size() == 6 && isCustomDraw(1, 0) && isCustomDraw(4, 1), 
+		"custom draws keep their submission position");
+	passed &= expect(renderer.getCommands().size() == 6 && renderer.getCommands()[2].texture == &textureA, 
+		"quads after a custom draw start a new command");
+
+	renderer.sort();
+
+	passed &= expect(renderer.getQuadOrder() == std::vector<uint32_t>{ 2, 3, 0, 1 }, 
+		"custom draws do not move any quads");
+	passed &= expect(renderer.getCommands().size() == 5 && isCustomDraw(2, 1) && isCustomDraw(4, 0), 
+		"custom draws sort after the quads of their own layer");
+	passed &= expect(renderer.getCommands().size() == 5 && renderer.getCommands()[3].numQuads == 2, 
+		"runs on both sides of a custom draw merge once sorted past it");
+	passed &= expect(renderer.hasMatchingCommands(quadTextures), "command ranges point at their own quads");
+
+	return passed;
+}
+
+static bool testSortManyTextures()
+{
+	constexpr uint32_t kNumTextures = 300;
+	constexpr uint32_t kNumQuads = 5000;
+
+	std::vector<Texture> textures(kNumTextures);
+	std::vector<Texture*> quadTextures(kNumQuads);
+	std::vector<uint32_t> quadLayers(kNumQuads);
+	std::mt19937 rng{ 7 };
+
+	TestBatchRenderer renderer;
+	for (uint32_t quadId = 0; quadId < kNumQuads; quadId++)
+	{
+		quadTextures[quadId] = &textures[rng() % kNumTextures];
+		quadLayers[quadId] = rng() % 3;
+
+		renderer.setLayer(quadLayers[quadId]);
+		renderer.drawQuad(quadTextures[quadId], quadId);
+	}
+
+	std::vector<uint32_t> textureRanks(kNumTextures, kNumTextures);
+	std::vector<uint32_t> expected(kNumQuads);
+	uint32_t numRanks{ 0 };
+
+	for (uint32_t quadId = 0; quadId < kNumQuads; quadId++)
+	{
+		auto& rank = textureRanks[quadTextures[quadId] - textures.data()];
+		if (rank == kNumTextures)
+		{
+			rank = numRanks++;
+		}
+
+		expected[quadId] = quadId;
+	}
+
+	std::stable_sort(expected.begin(), expected.end(), [&](auto a, auto b) {
+		if (quadLayers[a] != quadLayers[b])
+		{
+			return quadLayers[a] < quadLayers[b];
+		}
+
+		return textureRanks[quadTextures[a] - textures.data()] < textureRanks[quadTextures[b] - textures.data()];
+	});
+
+	renderer.sort();
+
+	bool passed{ true };
+	passed &= expect(renderer.getQuadOrder() == expected, "multi pass radix sort matches a stable reference sort");
+	passed &= expect(renderer.hasIntactQuads(), "every quad keeps its four vertices together");
+	passed &= expect(renderer.hasMatchingCommands(quadTextures), "command ranges point at their own quads");
+
+	return passed;
+}
+
+static bool testPackVertices()
+{
+	constexpr uint32_t kNumQuads = 8;
+
+	TestBatchRenderer renderer;
+	drawQuads(renderer, kNumQuads);
+
+	const auto& vertices = renderer.getVertices();
+	const auto& packedVertices = renderer.getPackedVertices();
+
+	bool passed{ true };
+	passed &= expect(sizeof(BatchRenderer::PackedVertex) == 16, "a packed vertex is 16 bytes");
+
+	for (uint32_t idx = 0; idx < kNumQuads * 4; idx++)
+	{
+		const auto& vertex = vertices[idx];
+		const auto& packedVertex = packedVertices[idx];
+
+		passed &= expect(packedVertex.position == vertex.position, "packed positions stay full precision");
+		passed &= expect(isNear(glm::unpackUnorm2x16(packedVertex.uv), vertex.uv, 1.0f / 65535.0f), 
+			"packed uvs round trip through unorm16");
+		passed &= expect(isNear(glm::unpackUnorm4x8(packedVertex.color), vertex.color, 1.0f / 255.0f), 
+			"packed colors round trip through unorm8");
+	}
+
+	return passed;
+}
+
+static bool testPackInstances()
+{
+	constexpr uint32_t kNumQuads = 8;
+	const glm::vec2 corners[] = { { 0.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f } };
+
+	TestBatchRenderer renderer;
+	drawQuads(renderer, kNumQuads);
+
+	const auto& vertices = renderer.getVertices();
+	const auto& instances = renderer.getInstances();
+
+	bool passed{ true };
+	passed &= expect(sizeof(BatchRenderer::QuadInstance) == 32, "a quad instance is 32 bytes");
+
+	for (uint32_t quad = 0; quad < kNumQuads; quad++)
+	{
+		const auto& instance = instances[quad];
+		const auto axisX = glm::unpackHalf2x16(instance.axisX);
+		const auto axisY = glm::unpackHalf2x16(instance.axisY);
+		const auto uvStart = glm::unpackUnorm2x16(instance.uvStart);
+		const auto uvEnd = glm::unpackUnorm2x16(instance.uvEnd);
+		const auto color = glm::unpackHalf4x16(instance.color);
+
+		for (uint32_t corner = 0; corner < 4; corner++)
+		{
+			const auto& vertex = vertices[quad * 4 + corner];
+			const auto& offset = corners[corner];
+
+			passed &= expect(isNear(instance.position + axisX * offset.x + axisY * offset.y, vertex.position, 0.05f), 
+				"instance corners rebuild the quad within half precision");
+			passed &= expect(isNear(uvStart + (uvEnd - uvStart) * offset, vertex.uv, 1.0f / 65535.0f), 
+				"instance uvs interpolate to the vertex uvs");
+			passed &= expect(isNear(color, vertex.color, 1.0f / 1024.0f), "instance colors round trip through half floats");
+		}
+	}
+
+	return passed;
+}
+
+int main()
+{
+	Logger logger;
+
+	return runTests({
+		{ "BatchRenderer sort is stable", testSortIsStable },
+		{ "BatchRenderer sort merges texture runs", testSortMergesRuns },
+		{ "BatchRenderer sort keeps shard layer order", testSortKeepsLayerOrder },
+		{ "BatchRenderer sort keeps custom draws in their layer", testSortKeepsCustomDraws },
+		{ "BatchRenderer sort handles many textures", testSortManyTextures },
+		{ "BatchRenderer packs vertices into 16 bytes", testPackVertices },
+		{ "BatchRenderer packs quads into 32 byte instances", testPackInstances }
+	});
+}
\ No newline at end of file
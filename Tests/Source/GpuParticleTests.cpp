@@ -0,0 +1,415 @@
+#include "TestRunner.h"
+#include "Particle/GpuParticlePool.h"
+#include "Particle/ParticlePool.h"
+#include "Graphics/GraphicsDevice.h"
+#include "Graphics/FrameBuffer.h"
+#include "Graphics/ComputePass.h"
+#include "Graphics/StorageBuffer.h"
+#include "Graphics/ReadbackBuffer.h"
+#include "Graphics/Texture.h"
+#include "VFS/FileSystem.h"
+#include "Core/Logger.h"
+#include "Core/Debugger.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace Trinity;
+
+static constexpr uint32_t kPoolSize = 1024;
+static constexpr uint32_t kNumFrames = 60;
+static constexpr uint32_t kNumEmitFrames = 10;
+static constexpr uint32_t kParticlesPerFrame = 24;
+static constexpr float kDeltaTime = 16.0f;
+static constexpr float kTolerance = 1e-3f;
+static constexpr auto kTimeout = std::chrono::seconds(10);
+
+struct ParticleState
+{
+	glm::vec2 position{ 0.0f };
+	glm::vec2 velocity{ 0.0f };
+	float lifeRemaining{ 0.0f };
+};
+
+static bool waitFor(const std::function<bool()>& condition)
+{
+	const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+	while (!condition())
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+
+		GraphicsDevice::get().poll();
+		std::this_thread::yield();
+	}
+
+	return true;
+}
+
+class TestParticlePool : public ParticlePool
+{
+public:
+
+	std::vector<ParticleState> getState() const
+	{
+		std::vector<ParticleState> state(mNumActive);
+		for (uint32_t idx = 0; idx < mNumActive; idx++)
+		{
+			state[idx] = {
+				.position = mPositions[idx],
+				.velocity = mVelocities[idx],
+				.lifeRemaining = mLifeRemaining[idx]
+			};
+		}
+
+		return state;
+	}
+};
+
+class TestGpuParticlePool : public GpuParticlePool
+{
+public:
+
+	bool waitForReadback()
+	{
+		return waitFor([this]() { return !mReadbackPending; });
+	}
+
+	bool getState(std::vector<ParticleState>& state)
+	{
+		uint32_t numAlive{ 0 };
+		std::vector<DrawArgs> drawArgs;
+		std::vector<GpuParticle> particles;
+
+		if (!readBuffers(numAlive, drawArgs, particles))
+		{
+			return false;
+		}
+
+		state.resize(numAlive);
+		for (uint32_t idx = 0; idx < numAlive; idx++)
+		{
+			state[idx] = {
+				.position = particles[idx].position,
+				.velocity = particles[idx].velocity,
+				.lifeRemaining = particles[idx].lifeRemaining
+			};
+		}
+
+		return true;
+	}
+
+	bool getSlotCounts(std::vector<uint32_t>& slotCounts, bool& bucketed)
+	{
+		uint32_t numAlive{ 0 };
+		std::vector<DrawArgs> drawArgs;
+		std::vector<GpuParticle> particles;
+
+		if (!readBuffers(numAlive, drawArgs, particles))
+		{
+			return false;
+		}
+
+		slotCounts.resize(mSlots.size());
+		bucketed = true;
+
+		uint32_t offset{ 0 };
+		for (uint32_t slot = 0; slot < (uint32_t)mSlots.size(); slot++)
+		{
+			slotCounts[slot] = drawArgs[slot].instanceCount;
+			for (uint32_t idx = offset; idx < offset + slotCounts[slot] && idx < numAlive; idx++)
+			{
+				bucketed &= particles[idx].slot == slot;
+			}
+
+			offset += slotCounts[slot];
+		}
+
+		bucketed &= offset == numAlive;
+		return true;
+	}
+
+private:
+
+	bool readBuffers(uint32_t& numAlive, std::vector<DrawArgs>& drawArgs, std::vector<GpuParticle>& particles)
+	{
+		const auto size = (uint32_t)sizeof(GpuParticle) * mNumParticles;
+		const auto& counterBuffer = *mComputeContext.counterBuffer;
+		const auto& drawArgsBuffer = *mComputeContext.drawArgsBuffer;
+		const auto& particleBuffer = *mComputeContext.particleBuffers[mSrc];
+
+		ReadbackBuffer counterReadback;
+		ReadbackBuffer drawArgsReadback;
+		ReadbackBuffer particleReadback;
+
+		if (!counterReadback.create(counterBuffer.getSize()) || !drawArgsReadback.create(drawArgsBuffer.getSize()) || 
+			!particleReadback.create(size))
+		{
+			return false;
+		}
+
+		ComputePass computePass;
+		if (!computePass.begin())
+		{
+			return false;
+		}
+
+		computePass.end();
+		computePass.copyBuffer(counterBuffer, 0, counterReadback, 0, counterBuffer.getSize());
+		computePass.copyBuffer(drawArgsBuffer, 0, drawArgsReadback, 0, drawArgsBuffer.getSize());
+		computePass.copyBuffer(particleBuffer, 0, particleReadback, 0, size);
+		computePass.submit();
+
+		drawArgs.resize(kMaxSlots);
+		particles.resize(mNumParticles);
+
+		bool countersMapped{ false };
+		bool drawArgsMapped{ false };
+		bool particlesMapped{ false };
+
+		counterReadback.onMapAsyncCompleted.subscribe([&](void* data) {
+			numAlive = reinterpret_cast<const uint32_t*>(data)[mSrc];
+			countersMapped = true;
+		});
+
+		drawArgsReadback.onMapAsyncCompleted.subscribe([&](void* data) {
+			std::memcpy(drawArgs.data(), data, sizeof(DrawArgs) * kMaxSlots);
+			drawArgsMapped = true;
+		});
+
+		particleReadback.onMapAsyncCompleted.subscribe([&](void* data) {
+			std::memcpy(particles.data(), data, size);
+			particlesMapped = true;
+		});
+
+		counterReadback.mapAsync(0, counterBuffer.getSize(), wgpu::MapMode::Read);
+		drawArgsReadback.mapAsync(0, drawArgsBuffer.getSize(), wgpu::MapMode::Read);
+		particleReadback.mapAsync(0, size, wgpu::MapMode::Read);
+
+		if (!waitFor([&]() { return countersMapped && drawArgsMapped && particlesMapped; }))
+		{
+			return false;
+		}
+
+		counterReadback.unmap();
+		drawArgsReadback.unmap();
+		particleReadback.unmap();
+
+		return true;
+	}
+};
+
+static bool createDevice(GraphicsDevice& graphicsDevice, wgpu::BackendType backendType, bool forceFallbackAdapter)
+{
+	bool created{ false };
+	graphicsDevice.onCreated.subscribe([&](bool result) {
+		created = result;
+	});
+
+	graphicsDevice.createHeadless(backendType, forceFallbackAdapter);
+	return created;
+}
+
+static bool createFrameBuffer(FrameBuffer& frameBuffer)
+{
+	return frameBuffer.create(64, 64) &&
+		frameBuffer.addColorAttachment(wgpu::TextureFormat::BGRA8Unorm, wgpu::TextureUsage::RenderAttachment);
+}
+
+static Particle createParticle(uint32_t frame, uint32_t idx)
+{
+	const auto id = (float)(frame * kParticlesPerFrame + idx);
+	return {
+		.position = { id, 2.0f * id },
+		.velocity = { 10.0f + 0.5f * (float)idx, -20.0f + (float)frame },
+		.acceleration = { 0.0f, -9.8f },
+		.startColor = glm::vec4{ 1.0f },
+		.finalColor = glm::vec4{ 0.0f },
+		.startSize = 8.0f,
+		.finalSize = 1.0f,
+		.drag = 0.99f,
+		.lifeSpan = 0.1f + 0.037f * (float)(idx % 17)
+	};
+}
+
+static bool sameState(std::vector<ParticleState> cpu, std::vector<ParticleState> gpu)
+{
+	auto compare = [](const ParticleState& lhs, const ParticleState& rhs) {
+		return lhs.position.x < rhs.position.x || (lhs.position.x == rhs.position.x && lhs.position.y < rhs.position.y);
+	};
+
+	std::sort(cpu.begin(), cpu.end(), compare);
+	std::sort(gpu.begin(), gpu.end(), compare);
+
+	auto isNear = [](float lhs, float rhs) {
+		return std::abs(lhs - rhs) <= kTolerance * std::max(1.0f, std::abs(lhs));
+	};
+
+	for (uint32_t idx = 0; idx < (uint32_t)cpu.size(); idx++)
+	{
+		const auto& lhs = cpu[idx];
+		const auto& rhs = gpu[idx];
+
+		if (!isNear(lhs.position.x, rhs.position.x) || !isNear(lhs.position.y, rhs.position.y) ||
+			!isNear(lhs.velocity.x, rhs.velocity.x) || !isNear(lhs.velocity.y, rhs.velocity.y) ||
+			!isNear(lhs.lifeRemaining, rhs.lifeRemaining))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool testCreateOnNullAdapter()
+{
+	GraphicsDevice graphicsDevice;
+	if (!createDevice(graphicsDevice, wgpu::BackendType::Null, false))
+	{
+		std::printf("    null adapter not available, skipped\n");
+		return true;
+	}
+
+	FrameBuffer frameBuffer;
+	TestGpuParticlePool pool;
+
+	bool passed{ true };
+	passed &= expect(createFrameBuffer(frameBuffer), "an offscreen frame buffer is created on the null adapter");
+	passed &= expect(pool.create(frameBuffer, kPoolSize), "the compute and render pipelines validate on the null adapter");
+
+	if (passed)
+	{
+		pool.emit(createParticle(0, 0));
+		pool.update(kDeltaTime);
+	}
+
+	return passed;
+}
+
+static bool testCpuMatchesGpu()
+{
+	GraphicsDevice graphicsDevice;
+	if (!createDevice(graphicsDevice, wgpu::BackendType::Undefined, true))
+	{
+		std::printf("    software adapter not available, skipped\n");
+		return true;
+	}
+
+	FrameBuffer frameBuffer;
+	TestParticlePool cpuPool;
+	TestGpuParticlePool gpuPool;
+
+	if (!expect(createFrameBuffer(frameBuffer) && gpuPool.create(frameBuffer, kPoolSize), "the GPU pool is created on the software adapter"))
+	{
+		return false;
+	}
+
+	cpuPool.init(kPoolSize);
+
+	bool passed{ true };
+	for (uint32_t frame = 0; frame < kNumFrames; frame++)
+	{
+		if (frame < kNumEmitFrames)
+		{
+			for (uint32_t idx = 0; idx < kParticlesPerFrame; idx++)
+			{
+				const auto particle = createParticle(frame, idx);
+				cpuPool.emit(particle);
+				gpuPool.emit(particle);
+			}
+		}
+
+		cpuPool.update(kDeltaTime);
+		gpuPool.update(kDeltaTime);
+
+		passed &= expect(gpuPool.waitForReadback(), "the live particle count is read back");
+		passed &= expect(gpuPool.getNumActive() == cpuPool.getNumActive(), "GPU and CPU pools report the same live count");
+
+		std::vector<ParticleState> gpuState;
+		passed &= expect(gpuPool.getState(gpuState), "the GPU particle buffer is read back");
+		passed &= expect(gpuState.size() == cpuPool.getNumActive(), "GPU and CPU pools keep the same particles alive");
+		passed &= expect(gpuState.size() != cpuPool.getNumActive() || sameState(cpuPool.getState(), gpuState),
+			"GPU and CPU pools integrate particles to the same state");
+
+		if (!passed)
+		{
+			std::printf("    diverged at frame %u\n", frame);
+			break;
+		}
+	}
+
+	passed &= expect(cpuPool.getNumActive() == 0, "every particle expires within the simulated frames");
+	return passed;
+}
+
+static bool testParticlesBucketBySlot()
+{
+	GraphicsDevice graphicsDevice;
+	if (!createDevice(graphicsDevice, wgpu::BackendType::Undefined, true))
+	{
+		std::printf("    software adapter not available, skipped\n");
+		return true;
+	}
+
+	FrameBuffer frameBuffer;
+	Texture textureA;
+	Texture textureB;
+	TestGpuParticlePool pool;
+
+	const auto usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst;
+	if (!expect(createFrameBuffer(frameBuffer) && pool.create(frameBuffer, kPoolSize) &&
+		textureA.create(16, 16, wgpu::TextureFormat::RGBA8Unorm, usage) &&
+		textureB.create(16, 16, wgpu::TextureFormat::RGBA8Unorm, usage), "the GPU pool and textures are created on the software adapter"))
+	{
+		return false;
+	}
+
+	Texture* textures[] = { &textureB, nullptr, &textureA };
+	for (uint32_t idx = 0; idx < kParticlesPerFrame * 3; idx++)
+	{
+		auto particle = createParticle(0, idx);
+		particle.textureFrame = {
+			.texture = textures[idx % 3],
+			.size = { 16.0f, 16.0f }
+		};
+
+		pool.emit(particle);
+	}
+
+	pool.update(kDeltaTime);
+
+	std::vector<uint32_t> slotCounts;
+	bool bucketed{ false };
+
+	bool passed{ true };
+	passed &= expect(pool.waitForReadback(), "the live particle count is read back");
+	passed &= expect(pool.getSlotCounts(slotCounts, bucketed), "the GPU draw arguments are read back");
+	passed &= expect(slotCounts == std::vector<uint32_t>(3, kParticlesPerFrame), "each slot draws only its own particles");
+	passed &= expect(bucketed, "live particles are compacted into one contiguous range per slot");
+
+	return passed;
+}
+
+int main()
+{
+	Logger logger;
+	Debugger debugger;
+	FileSystem fileSystem;
+
+	if (!fileSystem.addFolder("/Assets", "Assets"))
+	{
+		std::printf("Assets folder not found, run from the repository root\n");
+		return 1;
+	}
+
+	return runTests({
+		{ "GpuParticlePool creates on the null adapter", testCreateOnNullAdapter },
+		{ "GpuParticlePool matches ParticlePool on the software adapter", testCpuMatchesGpu },
+		{ "GpuParticlePool buckets particles by slot", testParticlesBucketBySlot }
+	});
+}
\ No newline at end of file
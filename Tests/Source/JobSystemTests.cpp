@@ -0,0 +1,190 @@
+#include "TestRunner.h"
+#include "Core/JobSystem.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Trinity;
+
+static constexpr auto kTimeout = std::chrono::seconds(10);
+
+static bool spinUntil(const std::function<bool()>& condition)
+{
+	const auto deadline = std::chrono::steady_clock::now() + kTimeout;
+	while (!condition())
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+
+		std::this_thread::yield();
+	}
+
+	return true;
+}
+
+static bool testParallelForCoversRange()
+{
+	struct Range
+	{
+		uint32_t count{ 0 };
+		uint32_t grainSize{ 0 };
+	};
+
+	const std::vector<Range> ranges = {
+		{ 0, 1 }, { 1, 1 }, { 1000, 1 }, { 1000, 64 }, { 1000, 1000 }, { 1001, 7 }, { 100000, 256 }
+	};
+
+	bool passed{ true };
+	for (uint32_t numWorkers : { 0u, 1u, 3u })
+	{
+		JobSystem jobSystem;
+		jobSystem.create(numWorkers);
+
+		for (auto& range : ranges)
+		{
+			auto visits = std::make_unique<std::atomic<uint32_t>[]>(range.count + 1);
+			jobSystem.parallelFor(range.count, range.grainSize, [&](uint32_t begin, uint32_t end) {
+				for (auto idx = begin; idx < end; idx++)
+				{
+					visits[idx].fetch_add(1);
+				}
+			});
+
+			for (uint32_t idx = 0; idx < range.count; idx++)
+			{
+				passed &= expect(visits[idx].load() == 1, "parallelFor visits every index exactly once");
+			}
+		}
+	}
+
+	return passed;
+}
+
+static bool testDependencies()
+{
+	JobSystem jobSystem;
+	jobSystem.create(3);
+
+	bool passed{ true };
+	for (uint32_t iteration = 0; iteration < 200; iteration++)
+	{
+		std::atomic<uint32_t> counter{ 0 };
+		uint32_t orderA{ 0 }, orderB{ 0 }, orderC{ 0 }, orderD{ 0 };
+
+		auto a = jobSystem.schedule([&]() { orderA = ++counter; });
+		auto b = jobSystem.schedule([&]() { orderB = ++counter; }, { a });
+		auto c = jobSystem.schedule([&]() { orderC = ++counter; }, { a });
+		auto d = jobSystem.schedule([&]() { orderD = ++counter; }, { b, c });
+
+		jobSystem.wait(d);
+
+		passed &= expect(a->finished && b->finished && c->finished, "waiting on a job implies its dependencies finished");
+		passed &= expect(orderA < orderB && orderA < orderC, "dependents run after their dependency");
+		passed &= expect(orderB < orderD && orderC < orderD, "a job with two dependencies runs after both");
+	}
+
+	auto finished = jobSystem.schedule([]() {});
+	jobSystem.wait(finished);
+
+	bool ran{ false };
+	auto late = jobSystem.schedule([&]() { ran = true; }, { finished });
+	jobSystem.wait(late);
+
+	passed &= expect(ran, "a job depending on an already finished job still runs");
+	return passed;
+}
+
+static bool testWaitHelps()
+{
+	JobSystem jobSystem;
+	jobSystem.create(1);
+
+	std::atomic<bool> released{ false };
+	std::atomic<uint32_t> releaseThread{ 0xffffffff };
+
+	auto blocker = jobSystem.schedule([&]() {
+		spinUntil([&]() { return released.load(); });
+	});
+
+	auto releaser = jobSystem.schedule([&]() {
+		releaseThread = JobSystem::getThreadIndex();
+		released = true;
+	});
+
+	jobSystem.wait({ blocker, releaser });
+
+	bool passed{ true };
+	passed &= expect(released.load(), "the releasing job ran");
+	passed &= expect(releaseThread.load() == 0, "the waiting thread ran queued work instead of blocking");
+
+	return passed;
+}
+
+static bool testIdleWorkersSteal()
+{
+	static constexpr uint32_t kNumChildren = 64;
+
+	JobSystem jobSystem;
+	jobSystem.create(3);
+
+	std::atomic<uint32_t> spawnerThread{ 0xffffffff };
+	std::atomic<uint32_t> numFinished{ 0 };
+	std::atomic<uint32_t> numStolen{ 0 };
+
+	auto spawner = jobSystem.schedule([&]() {
+		spawnerThread = JobSystem::getThreadIndex();
+
+		for (uint32_t idx = 0; idx < kNumChildren; idx++)
+		{
+			jobSystem.schedule([&]() {
+				if (JobSystem::getThreadIndex() != spawnerThread.load())
+				{
+					numStolen++;
+				}
+
+				numFinished++;
+			});
+		}
+
+		spinUntil([&]() { return numFinished.load() == kNumChildren; });
+	});
+
+	jobSystem.wait(spawner);
+	spinUntil([&]() { return numFinished.load() == kNumChildren; });
+
+	bool passed{ true };
+	passed &= expect(numFinished.load() == kNumChildren, "every child job ran while the spawner was busy");
+	passed &= expect(numStolen.load() == kNumChildren, "child jobs were stolen from the busy thread's deque");
+
+	return passed;
+}
+
+static bool testNoWorkers()
+{
+	JobSystem jobSystem;
+	jobSystem.create(0);
+
+	bool ran{ false };
+	auto handle = jobSystem.schedule([&]() { ran = true; });
+
+	bool passed{ true };
+	passed &= expect(ran && handle->finished, "without workers a job runs inline when scheduled");
+
+	jobSystem.wait(handle);
+	return passed;
+}
+
+int main()
+{
+	return runTests({
+		{ "JobSystem.parallelFor covers the range", testParallelForCoversRange },
+		{ "JobSystem.schedule honours dependencies", testDependencies },
+		{ "JobSystem.wait helps on the calling thread", testWaitHelps },
+		{ "JobSystem idle workers steal queued jobs", testIdleWorkersSteal },
+		{ "JobSystem without workers runs inline", testNoWorkers }
+	});
+}
\ No newline at end of file
@@ -0,0 +1,376 @@
+#include "TestRunner.h"
+#include "TileMap/TileLayer.h"
+#include "VFS/File.h"
+#include "VFS/FileReader.h"
+#include "VFS/FileWriter.h"
+#include "Core/ResourceCache.h"
+#include "Core/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace Trinity;
+
+class MemoryFile : public File
+{
+public:
+
+	MemoryFile(std::vector<uint8_t>& data, FileOpenMode openMode)
+		: mData(data)
+	{
+		mOpenMode = openMode;
+		mSize = (uint32_t)data.size();
+	}
+
+	virtual bool isEOF() const override
+	{
+		return mPosition >= (uint32_t)mData.size();
+	}
+
+	virtual bool seek(SeekOrigin origin, int32_t offset) override
+	{
+		const auto base = origin == SeekOrigin::Beginning ? 0 : 
+			origin == SeekOrigin::Current ? (int32_t)mPosition : (int32_t)mData.size();
+
+		if (base + offset < 0 || base + offset > (int32_t)mData.size())
+		{
+			return false;
+		}
+
+		mPosition = (uint32_t)(base + offset);
+		return true;
+	}
+
+	virtual bool read(void* data, uint32_t size, uint32_t* readSize = nullptr) override
+	{
+		if (!canRead() || mPosition + size > (uint32_t)mData.size())
+		{
+			return false;
+		}
+
+		std::memcpy(data, mData.data() + mPosition, size);
+		mPosition += size;
+
+		if (readSize != nullptr)
+		{
+			*readSize = size;
+		}
+
+		return true;
+	}
+
+	virtual bool write(const void* data, uint32_t size, uint32_t* writeSize = nullptr) override
+	{
+		if (!canWrite())
+		{
+			return false;
+		}
+
+		const auto* bytes = (const uint8_t*)data;
+		mData.insert(mData.end(), bytes, bytes + size);
+		mPosition += size;
+		mSize = (uint32_t)mData.size();
+
+		if (writeSize != nullptr)
+		{
+			*writeSize = size;
+		}
+
+		return true;
+	}
+
+private:
+
+	std::vector<uint8_t>& mData;
+};
+
+class TestTileLayer : public TileLayer
+{
+public:
+
+	uint32_t getNumAllocatedChunks() const
+	{
+		return (uint32_t)std::count_if(mSparseChunks.begin(), mSparseChunks.end(), [](const auto& chunk) {
+			return !chunk.empty();
+		});
+	}
+};
+
+static std::vector<uint32_t> createTiles(uint32_t numTiles, uint32_t seed)
+{
+	std::mt19937 rng{ seed };
+	std::uniform_int_distribution<uint32_t> dist{ 0, 3 };
+
+	std::vector<uint32_t> tiles(numTiles);
+	for (auto& tile : tiles)
+	{
+		tile = dist(rng) == 0 ? dist(rng) + 1 : 0;
+	}
+
+	return tiles;
+}
+
+static bool writeLayer(TileLayer& layer, std::vector<uint8_t>& bytes)
+{
+	MemoryFile file{ bytes, FileOpenMode::OpenWrite };
+	FileWriter writer{ file };
+
+	return layer.getSerializer()->write(writer);
+}
+
+static bool readLayer(TileLayer& layer, std::vector<uint8_t>& bytes)
+{
+	MemoryFile file{ bytes, FileOpenMode::OpenRead };
+	FileReader reader{ file };
+	ResourceCache cache;
+
+	return layer.getSerializer()->read(reader, cache);
+}
+
+static bool testRuns()
+{
+	TileLayerSerializer serializer;
+	const std::vector<std::vector<uint32_t>> inputs = {
+		{}, { 0 }, { 7, 7, 7 }, { 1, 2, 3 }, { 0, 0, 5, 5, 5, 0 }, createTiles(4096, 1)
+	};
+
+	bool passed{ true };
+	for (auto& input : inputs)
+	{
+		std::vector<uint32_t> tiles;
+		const auto runs = serializer.encodeRuns(input);
+
+		passed &= expect(runs.size() % 2 == 0, "encodeRuns emits (count, value) pairs");
+		passed &= expect(serializer.decodeRuns(runs, tiles) && tiles == input, "decodeRuns restores encodeRuns input");
+	}
+
+	std::vector<uint32_t> tiles;
+	passed &= expect(serializer.encodeRuns({ 4, 4, 4, 4 }) == std::vector<uint32_t>{ 4, 4 }, 
+		"equal tiles collapse into one run");
+	passed &= expect(!serializer.decodeRuns({ 1, 2, 3 }, tiles), "decodeRuns rejects an odd run list");
+	passed &= expect(!serializer.decodeRuns({ 4097, 1 }, tiles), "decodeRuns rejects runs larger than a chunk");
+
+	return passed;
+}
+
+static bool testSquareChunks()
+{
+	TestTileLayer layer;
+	layer.setStorage(TileLayerStorage::Sparse);
+	layer.resize(8192, 256);
+
+	for (uint32_t y = 64; y < 128; y++)
+	{
+		for (uint32_t x = 128; x < 192; x++)
+		{
+			layer.setTile(y * 8192 + x, 1);
+		}
+	}
+
+	bool passed{ true };
+	passed &= expect(layer.getNumAllocatedChunks() == 1, "a chunk aligned 64x64 block allocates a single chunk");
+	passed &= expect(layer.getTile(64 * 8192 + 128) == 1 && layer.getTile(127 * 8192 + 191) == 1, 
+		"tiles inside the block are stored");
+	passed &= expect(layer.getTile(64 * 8192 + 192) == 0 && layer.getTile(128 * 8192 + 128) == 0, 
+		"tiles outside the block read as empty");
+
+	for (uint32_t y = 64; y < 128; y++)
+	{
+		for (uint32_t x = 128; x < 192; x++)
+		{
+			layer.setTile(y * 8192 + x, 0);
+		}
+	}
+
+	passed &= expect(layer.getNumAllocatedChunks() == 0, "clearing every tile releases the chunk");
+
+	return passed;
+}
+
+static bool testResizeWithinChunk()
+{
+	TestTileLayer layer;
+	layer.setStorage(TileLayerStorage::Sparse);
+	layer.resize(100, 100);
+
+	layer.setTile(70 * 100 + 5, 3);
+	layer.setTile(90 * 100 + 5, 4);
+	layer.setTile(90 * 100 + 80, 5);
+
+	layer.resize(100, 80);
+
+	bool passed{ true };
+	passed &= expect(layer.getSize() == 8000, "resize updates the size");
+	passed &= expect(layer.getTile(70 * 100 + 5) == 3, "tiles above the new height survive");
+	passed &= expect(layer.getNumAllocatedChunks() == 1, "chunks emptied by the shrink are released");
+
+	layer.resize(100, 100);
+
+	passed &= expect(layer.getTile(90 * 100 + 5) == 0 && layer.getTile(90 * 100 + 80) == 0, 
+		"tiles cut by the shrink stay cleared after growing back");
+	passed &= expect(layer.getTile(70 * 100 + 5) == 3, "tiles above the cut are unchanged");
+
+	layer.resize(50, 200);
+
+	passed &= expect(layer.getTile(70 * 100 + 5) == 3, "changing the width keeps the linear tile index");
+
+	return passed;
+}
+
+static bool testStorageConversion()
+{
+	const auto tiles = createTiles(130 * 70, 2);
+
+	TestTileLayer layer;
+	layer.resize(130, 70);
+	layer.setData(std::vector<uint32_t>{ tiles });
+	layer.setStorage(TileLayerStorage::Sparse);
+
+	bool passed{ true };
+	passed &= expect(layer.getStorage() == TileLayerStorage::Sparse, "layer switched to sparse storage");
+	passed &= expect(layer.getSize() == (uint32_t)tiles.size(), "sparse size matches the dense size");
+	passed &= expect(layer.getDenseData() == tiles, "sparse storage holds the dense tiles");
+
+	for (uint32_t idx = 0; idx < (uint32_t)tiles.size(); idx += 97)
+	{
+		passed &= expect(layer.getTile(idx) == tiles[idx], "sparse getTile matches the dense tile");
+	}
+
+	layer.setStorage(TileLayerStorage::Dense);
+
+	passed &= expect(layer.getStorage() == TileLayerStorage::Dense, "layer switched back to dense storage");
+	passed &= expect(layer.getDenseData() == tiles, "dense storage holds the original tiles");
+	passed &= expect(layer.getNumAllocatedChunks() == 0, "dense storage releases the sparse chunks");
+
+	return passed;
+}
+
+static bool testReadLegacyDense()
+{
+	std::vector<uint8_t> bytes;
+	{
+		MemoryFile file{ bytes, FileOpenMode::OpenWrite };
+		FileWriter writer{ file };
+
+		const uint32_t numObjects{ 0 };
+		writer.writeString("legacy");
+		writer.writeVector(std::vector<uint32_t>{ 7, 8, 0, 9 });
+		writer.write(&numObjects);
+	}
+
+	TileLayer layer;
+
+	bool passed{ true };
+	passed &= expect(readLayer(layer, bytes), "legacy dense layer reads");
+	passed &= expect(layer.getName() == "legacy", "legacy name is read");
+	passed &= expect(layer.getDenseData() == std::vector<uint32_t>{ 7, 8, 0, 9 }, "legacy tiles are read");
+	passed &= expect(layer.getParallax() == glm::vec2{ 1.0f }, "legacy layer keeps the default parallax");
+
+	return passed;
+}
+
+static bool testReadLegacySparse()
+{
+	const auto tiles = createTiles(5000, 3);
+	TileLayerSerializer serializer;
+
+	std::vector<uint8_t> bytes;
+	{
+		MemoryFile file{ bytes, FileOpenMode::OpenWrite };
+		FileWriter writer{ file };
+
+		const uint32_t version{ 1 };
+		const uint32_t numTiles = (uint32_t)tiles.size();
+		const uint32_t numChunks{ 2 };
+		const uint32_t numObjects{ 0 };
+		const glm::vec2 offset{ 0.0f };
+		const glm::vec2 parallax{ 1.0f };
+
+		writer.writeString("strips");
+		writer.write(&TileLayer::kVersionMarker);
+		writer.write(&version);
+		writer.write(&offset);
+		writer.write(&parallax);
+		writer.write(&TileLayer::kSparseMarker);
+		writer.write(&numTiles);
+		writer.write(&numChunks);
+
+		for (uint32_t chunkIdx = 0; chunkIdx < numChunks; chunkIdx++)
+		{
+			const auto begin = tiles.begin() + chunkIdx * 4096;
+			const auto end = tiles.begin() + std::min<size_t>((chunkIdx + 1) * 4096, tiles.size());
+
+			writer.write(&chunkIdx);
+			writer.writeVector(serializer.encodeRuns(std::vector<uint32_t>{ begin, end }));
+		}
+
+		writer.write(&numObjects);
+	}
+
+	TileLayer layer;
+
+	bool passed{ true };
+	passed &= expect(readLayer(layer, bytes), "version 1 sparse layer reads");
+	passed &= expect(layer.getStorage() == TileLayerStorage::Sparse, "version 1 sparse layer stays sparse");
+	passed &= expect(layer.getDenseData() == tiles, "version 1 strip chunks are read");
+
+	return passed;
+}
+
+static bool testBinaryRoundTrip()
+{
+	const auto tiles = createTiles(200 * 150, 4);
+
+	bool passed{ true };
+	for (auto storage : { TileLayerStorage::Dense, TileLayerStorage::Sparse })
+	{
+		TileLayer layer;
+		layer.setName("ground");
+		layer.resize(200, 150);
+		layer.setData(std::vector<uint32_t>{ tiles });
+		layer.setStorage(storage);
+		layer.setOffset({ 3.0f, 4.0f });
+		layer.setParallax({ 0.5f, 0.25f });
+		layer.setObjects({ TileObject{ { 1.0f, 1.0f }, { 2.0f, 2.0f }, { { "key", "value" } } } });
+
+		std::vector<uint8_t> bytes;
+		passed &= expect(writeLayer(layer, bytes), "layer writes");
+
+		uint32_t marker{ 0 };
+		std::memcpy(&marker, bytes.data() + sizeof(uint32_t) + layer.getName().size(), sizeof(uint32_t));
+		passed &= expect(marker == TileLayer::kVersionMarker, "layer starts with the version marker");
+
+		TileLayer result;
+		passed &= expect(readLayer(result, bytes), "layer reads");
+		passed &= expect(result.getName() == "ground", "name survives the round trip");
+		passed &= expect(result.getStorage() == storage, "storage survives the round trip");
+		passed &= expect(result.getOffset() == glm::vec2{ 3.0f, 4.0f }, "offset survives the round trip");
+		passed &= expect(result.getParallax() == glm::vec2{ 0.5f, 0.25f }, "parallax survives the round trip");
+		passed &= expect(result.getDenseData() == tiles, "tiles survive the round trip");
+		passed &= expect(result.getObjects().size() == 1 && 
+			result.getObjects()[0].properties.at("key") == "value", "objects survive the round trip");
+
+		if (storage == TileLayerStorage::Sparse)
+		{
+			passed &= expect(result.getNumTiles() == glm::uvec2{ 200, 150 }, "sparse width and height survive the round trip");
+		}
+	}
+
+	return passed;
+}
+
+int main()
+{
+	Logger logger;
+
+	return runTests({
+		{ "TileLayerSerializer encodes and decodes runs", testRuns },
+		{ "TileLayer sparse chunks are square", testSquareChunks },
+		{ "TileLayer resize shrinks within a partial chunk", testResizeWithinChunk },
+		{ "TileLayer converts dense to sparse and back", testStorageConversion },
+		{ "TileLayerSerializer reads the legacy dense format", testReadLegacyDense },
+		{ "TileLayerSerializer reads version 1 sparse strips", testReadLegacySparse },
+		{ "TileLayerSerializer round trips the versioned format", testBinaryRoundTrip }
+	});
+}
\ No newline at end of file